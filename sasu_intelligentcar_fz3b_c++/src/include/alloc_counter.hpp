@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <malloc.h>
+
+/**
+ * @brief 堆内存分配计数（glibc）：替换malloc系列函数，统计进程内的分配次数
+ *
+ * operator new、OpenCV/Paddle内部分配最终均经过malloc系列函数，统计区间前后计数相减即为区间内分配次数
+ * @note 替换的是全局符号，只能在工具程序的一个编译单元中包含
+ */
+extern "C"
+{
+  void *__libc_malloc(size_t size);
+  void *__libc_calloc(size_t count, size_t size);
+  void *__libc_realloc(void *ptr, size_t size);
+  void *__libc_memalign(size_t alignment, size_t size);
+  void __libc_free(void *ptr);
+}
+
+inline std::atomic<uint64_t> &allocCounter()
+{
+  static std::atomic<uint64_t> counter{0};
+  return counter;
+}
+
+/**
+ * @brief 累计分配次数
+ *
+ */
+inline uint64_t allocCount() { return allocCounter().load(std::memory_order_relaxed); }
+
+extern "C"
+{
+  void *malloc(size_t size) noexcept
+  {
+    allocCounter().fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+  }
+
+  void *calloc(size_t count, size_t size) noexcept
+  {
+    allocCounter().fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+  }
+
+  void *realloc(void *ptr, size_t size) noexcept
+  {
+    allocCounter().fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+  }
+
+  void *memalign(size_t alignment, size_t size) noexcept
+  {
+    allocCounter().fetch_add(1, std::memory_order_relaxed);
+    return __libc_memalign(alignment, size);
+  }
+
+  void *aligned_alloc(size_t alignment, size_t size) noexcept
+  {
+    allocCounter().fetch_add(1, std::memory_order_relaxed);
+    return __libc_memalign(alignment, size);
+  }
+
+  int posix_memalign(void **ptr, size_t alignment, size_t size) noexcept
+  {
+    allocCounter().fetch_add(1, std::memory_order_relaxed);
+    *ptr = __libc_memalign(alignment, size);
+    return *ptr ? 0 : ENOMEM;
+  }
+
+  void free(void *ptr) noexcept { __libc_free(ptr); }
+}
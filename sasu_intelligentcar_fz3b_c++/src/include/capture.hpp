@@ -1,25 +1,56 @@
 #pragma once
+#include <chrono>
 #include <memory>
 #include <opencv2/opencv.hpp>
 #include "common.hpp"
+#include "v4l2_capture.hpp"
 #include <opencv2/core/ocl.hpp>
 
+/**
+ * @brief 采集参数：V4L2原生采集（仅对/dev/videoX设备生效）
+ *
+ */
+struct CaptureParams
+{
+  bool v4l2 = false;  // V4L2 mmap零拷贝采集（false：cv::VideoCapture）
+  bool mjpeg = false; // 像素格式：MJPEG（false：YUYV）
+  int buffers = 6;    // 驱动缓存队列深度：需大于下游同时持有的帧数+1
+};
+
 class Capture
 {
 private:
   std::shared_ptr<cv::VideoCapture> _capture;
+  std::shared_ptr<V4l2Capture> _v4l2;
+  CaptureParams _params;
   std::string path;
   int dev_index;
   bool _isOpend = false;
+  std::chrono::steady_clock::time_point _timestamp;
+  std::shared_ptr<void> _lease; // 最近一帧的驱动缓存占用标记（不指定lease时使用）
 
 public:
+
   int open(int dev_index)
   {
+    if (_params.v4l2)
+      return open("/dev/video" + std::to_string(dev_index));
     _capture = std::make_shared<cv::VideoCapture>(dev_index);
     return _open();
   }
   int open(std::string path)
   {
+    if (_params.v4l2 && path.rfind("/dev/video", 0) == 0) // V4L2设备
+    {
+      _v4l2 = std::make_shared<V4l2Capture>();
+      if (_v4l2->open(path, COLSIMAGE, ROWSIMAGE, _params.mjpeg, _params.buffers) != 0)
+      {
+        _v4l2 = nullptr;
+        return -1;
+      }
+      _isOpend = true;
+      return 0;
+    }
     _capture = std::make_shared<cv::VideoCapture>(path);
     return _open();
   };
@@ -28,19 +59,71 @@ public:
   cv::Mat read()
   {
     cv::Mat frame;
-    if (is_open())
-    {
-      _capture->read(frame);
-    }
+    read(frame);
     return frame;
   };
+  /**
+   * @brief 读取一帧到已有图像：尺寸/类型不变时复用图像内存
+   *
+   * @note V4L2零拷贝帧在下一次read()前有效
+   */
+  bool read(cv::Mat &frame) { return read(frame, _lease); };
+
+  /**
+   * @brief 读取一帧并取得其缓存占用标记
+   *
+   * @param frame 输出图像（V4L2 YUYV为指向驱动缓存的CV_8UC2图像）
+   * @param lease 缓存占用标记：持有期间零拷贝帧有效（VideoCapture为空）
+   */
+  bool read(cv::Mat &frame, std::shared_ptr<void> &lease)
+  {
+    if (!is_open())
+      return false;
+    if (_v4l2 != nullptr)
+      return _v4l2->read(frame, lease);
+    lease = nullptr;
+    bool ret = _capture->read(frame);
+    _timestamp = std::chrono::steady_clock::now();
+    return ret;
+  };
+
+  /**
+   * @brief 最近一帧的采集时刻（V4L2为驱动时间戳）
+   *
+   */
+  std::chrono::steady_clock::time_point timestamp()
+  {
+    if (_v4l2 != nullptr)
+      return _v4l2->timestamp();
+    return _timestamp;
+  }
+
+  /**
+   * @brief 转换为BGR图像：YUYV帧需转换，其它直接拷贝
+   *
+   */
+  static void toBgr(const cv::Mat &frame, cv::Mat &bgr)
+  {
+    if (frame.channels() == 2)
+      cv::cvtColor(frame, bgr, cv::COLOR_YUV2BGR_YUYV);
+    else
+      frame.copyTo(bgr);
+  }
+
   void close()
   {
     _isOpend = false;
+    if (_v4l2 != nullptr)
+    {
+      _v4l2->close();
+      _v4l2 = nullptr;
+      return;
+    }
     _capture->release();
   }
 
   Capture(){};
+  Capture(CaptureParams params) : _params(params){};
   ~Capture(){};
 
 private:
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "json.hpp"
+#include "recorder.hpp"
 #include <fstream>
 #include <iostream>
 #include <opencv2/highgui.hpp> //OpenCV终端部署
@@ -20,14 +21,7 @@ using namespace cv;
 #define PWMSERVOMID 1560 // 舵机PWM中值 1540是标准值
 #define PWMSERVOMIN 1210 // 舵机PWM最小值（右）1170是标准值
 
-#define LABEL_CONE "cone"           // AI标签：锥桶
-#define LABEL_GRANARY "granary"     // AI标签：谷仓
-#define LABEL_BRIDGE "bridge"       // AI标签：桥
-#define LABEL_TRACTOR "tractor"     // AI标签：拖拉机
-#define LABEL_CORN "corn"           // AI标签：玉米
-#define LABEL_PIG "pig"             // AI标签：猪
-#define LABEL_CROSSWALK "crosswalk" // AI标签：斑马线
-#define LABEL_BUMP "bump"           // AI标签：减速带
+// AI标签：类别ID（LABEL_CONE/LABEL_CROSSWALK等）由CMake根据label_list.txt生成，见label_id.hpp
 
 bool printAiEnable = false;
 PerspectiveMapping ipm; // 逆透视变换公共类
@@ -43,19 +37,13 @@ struct POINT
 };
 
 /**
- * @brief 存储图像至本地
+ * @brief 存储图像至本地：拷贝后交由后台线程编码写入（../res/samples/train/N.jpg）
  *
  * @param image 需要存储的图像
  */
 void savePicture(Mat &image)
 {
-    // 存图
-    string name = ".png";
-    static int counter = 0;
-    counter++;
-    string img_path = "../res/samples/train/";
-    name = img_path + to_string(counter) + ".jpg";
-    imwrite(name, image);
+    Recorder::instance().push(image);
 }
 
 //--------------------------------------------------[公共方法]----------------------------------------------------
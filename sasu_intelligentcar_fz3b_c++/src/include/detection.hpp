@@ -1,18 +1,38 @@
 #pragma once
 
 #include "capture.hpp"
+#include "frame_mailbox.hpp"
 #include "predictor.hpp"
+#include "profiler.hpp"
 #include "mat_util.hpp"
 #include "stop_watch.hpp"
-#include <condition_variable>
-#include <mutex>
+#include <chrono>
 #include <thread>
 
 struct DetectionResult
 {
   cv::Mat det_render_frame;
+  cv::Mat rgb_frame;          // 原始图像：V4L2 YUYV采集时为指向驱动缓存的CV_8UC2图像
+  std::shared_ptr<void> frame_lease; // 驱动缓存占用标记：持有期间rgb_frame有效
+  std::vector<PredictResult> predictor_results; // 最新一次的AI结果：推理慢于采集时连续多帧相同
+  uint64_t frame_id = 0;     // 图像帧序号（采集顺序，从1开始）
+  uint64_t det_frame_id = 0; // AI结果对应的图像帧序号（0：尚无AI结果）
+  uint64_t det_age = 0;      // AI结果滞后的帧数：frame_id - det_frame_id
+  double det_age_ms = 0;     // AI结果滞后的时间（两帧采集时刻之差）
+  std::chrono::steady_clock::time_point stamp; // 图像采集时刻
+};
+
+/**
+ * @brief AI推理的输入帧与推理结果
+ *
+ */
+struct InferenceFrame
+{
   cv::Mat rgb_frame;
+  cv::Mat det_render_frame;
   std::vector<PredictResult> predictor_results;
+  uint64_t frame_id = 0;
+  std::chrono::steady_clock::time_point stamp; // 采集时刻
 };
 
 class Detection
@@ -22,11 +42,12 @@ public:
   Detection(bool logEn = false) : _log_en(logEn) {}
   ~Detection() {}
 
-  int init(std::string file_path, std::string model_config_path)
+  int init(std::string file_path, std::string model_config_path,
+           CaptureParams params = CaptureParams())
   {
     _is_file = true;
     _file_path = file_path;
-    _capture = std::make_shared<Capture>();
+    _capture = std::make_shared<Capture>(leaseParams(params));
     if (_capture == nullptr)
     {
       std::cout << "Capture create failed." << std::endl;
@@ -41,9 +62,10 @@ public:
     return _init(model_config_path);
   };
 
-  int init(int camera_index, std::string model_config_path)
+  int init(int camera_index, std::string model_config_path,
+           CaptureParams params = CaptureParams())
   {
-    _capture = std::make_shared<Capture>();
+    _capture = std::make_shared<Capture>(leaseParams(params));
     if (_capture == nullptr)
     {
       std::cout << "Capture create failed." << std::endl;
@@ -57,17 +79,30 @@ public:
     }
     return _init(model_config_path);
   };
+  /**
+   * @brief 启动采集线程与推理线程
+   *
+   * 采集线程每帧立即发布给控制循环，并附带最新一次的AI结果；
+   * 推理线程只处理能取到的最新帧，控制频率不再受限于模型推理速度
+   */
   void start()
   {
     _thread = std::make_unique<std::thread>([this]()
                                             {
+      pthread_setname_np(pthread_self(), "capture"); // 分阶段计时/时间线的线程名
+      uint64_t frame_id = 0;
+      std::shared_ptr<InferenceFrame> latest = nullptr; // 最新一次的AI结果
       while (1) {
-        std::shared_ptr<DetectionResult> result =
-            std::make_shared<DetectionResult>();
+        // 预分配槽位：复用图像内存，不再逐帧申请DetectionResult
+        std::shared_ptr<DetectionResult> &result = _mailbox.back();
 
         StopWatch stop_watch_capture;
         stop_watch_capture.tic();
-        result->rgb_frame = _capture->read();
+        {
+          PROFILE_SCOPE("capture");
+          _capture->read(result->rgb_frame, result->frame_lease);
+        }
+        auto stamp = _capture->timestamp(); // 采集时刻（V4L2为驱动时间戳）
         //reopen file
         if (result->rgb_frame.empty() && _is_file) {
           _capture->close();
@@ -85,56 +120,107 @@ public:
           std::cout << "Error: Capture Get Empty Error Frame." << std::endl;
           exit(-1);
         }
-        result->predictor_results = _predictor->run(result->rgb_frame);
+        result->frame_id = ++frame_id;
+        result->stamp = stamp;
 
-        if(printAiEnable) //绘制AI识别结果
-        {
-          result->det_render_frame = result->rgb_frame.clone();
-          _predictor->render(result->det_render_frame, result->predictor_results);
+        // 推理线程输入：拷贝到推理信箱，推理未完成时旧帧被覆盖
+        std::shared_ptr<InferenceFrame> &input = _inputs.back();
+        Capture::toBgr(result->rgb_frame, input->rgb_frame);
+        input->frame_id = frame_id;
+        input->stamp = stamp;
+        _inputs.publish();
+
+        // 附带最新一次的AI结果及其滞后程度
+        if (_outputs.published())
+          latest = _outputs.take(false);
+        if (latest != nullptr) {
+          result->predictor_results = latest->predictor_results;
+          if (printAiEnable)
+            latest->det_render_frame.copyTo(result->det_render_frame);
+          result->det_frame_id = latest->frame_id;
+          result->det_age = frame_id - latest->frame_id;
+          result->det_age_ms = std::chrono::duration<double, std::milli>(
+                                   stamp - latest->stamp)
+                                   .count();
+        } else if (printAiEnable) {
+          Capture::toBgr(result->rgb_frame, result->det_render_frame);
         }
 
-        _predictor->transmitLabels(result->predictor_results);//标签转换
-        
-        //多线程共享数据传递
-        std::unique_lock<std::mutex> lock(_mutex);
-        _lastResult = result;
-        cond_.notify_all();
+        //多线程共享数据传递：无锁三缓冲
+        _mailbox.publish();
         if(printAiEnable)//调试模式下降低帧率
         {
           waitKey(30);
         }
           
       } });
+
+    _threadInference = std::make_unique<std::thread>([this]()
+                                                     {
+      pthread_setname_np(pthread_self(), "inference");
+      while (1) {
+        std::shared_ptr<InferenceFrame> *taken;
+        {
+          PROFILE_SCOPE("wait_input"); // 等待采集线程的新帧
+          taken = &_inputs.take(true);
+        }
+        std::shared_ptr<InferenceFrame> &input = *taken; // 最新帧
+        std::shared_ptr<InferenceFrame> &output = _outputs.back();
+
+        _predictor->run(input->rgb_frame, output->predictor_results,
+                        input->frame_id); // 复用槽位内存
+        if(printAiEnable) //绘制AI识别结果
+        {
+          input->rgb_frame.copyTo(output->det_render_frame);
+          _predictor->render(output->det_render_frame, output->predictor_results);
+        }
+        output->frame_id = input->frame_id;
+        output->stamp = input->stamp;
+
+        _outputs.publish();
+      } });
   }
   int stop() { return 0; }
   int deinit() { return 0; }
 
-  std::shared_ptr<DetectionResult> getLastFrame()
+  /**
+   * @brief 获取最新一帧的识别结果
+   *
+   * @param wait true：等待新帧；false：不阻塞，无新帧时返回上一帧
+   * @return std::shared_ptr<DetectionResult> 识别结果（在下一次调用前有效）
+   */
+  std::shared_ptr<DetectionResult> getLastFrame(bool wait = true)
   {
-    std::shared_ptr<DetectionResult> ret = nullptr;
-    {
-      std::unique_lock<std::mutex> lock(_mutex);
+    return _mailbox.take(wait);
+  }
 
-      while (_lastResult == nullptr)
-      {
-        cond_.wait(lock);
-      }
-      ret = _lastResult;
-      _lastResult = nullptr;
-    }
-    return ret;
+  /**
+   * @brief 帧传递统计：发布/读取/覆盖丢弃/重复读取
+   *
+   */
+  void printFrameStatistics()
+  {
+    std::cout << "Detection frames: published = " << _mailbox.published()
+              << " consumed = " << _mailbox.consumed()
+              << " dropped = " << _mailbox.dropped()
+              << " repeated = " << _mailbox.repeated() << std::endl;
+    std::cout << "Inference frames: captured = " << _inputs.published()
+              << " inferred = " << _inputs.consumed()
+              << " skipped = " << _inputs.dropped() << std::endl;
+    _predictor->printLatency();
   }
 
   std::string getLabel(int type) { return _predictor->getLabel(type); }
 
 public:
-  static std::shared_ptr<Detection> DetectionInstance(std::string file_path, std::string model_path)
+  static std::shared_ptr<Detection> DetectionInstance(std::string file_path, std::string model_path,
+                                                      CaptureParams params = CaptureParams())
   {
     static std::shared_ptr<Detection> detectioner = nullptr;
     if (detectioner == nullptr)
     {
       detectioner = std::make_shared<Detection>();
-      int ret = detectioner->init(file_path, model_path);
+      int ret = detectioner->init(file_path, model_path, params);
       if (ret != 0)
       {
         std::cout << "Detection init error :" << model_path << std::endl;
@@ -185,12 +271,27 @@ private:
   bool _is_file = false;
   std::string _file_path;
   bool _log_en;
-  std::shared_ptr<DetectionResult> _lastResult;
+  FrameMailbox<DetectionResult> _mailbox; // 最新帧信箱：采集 -> 控制
+  FrameMailbox<InferenceFrame> _inputs;   // 推理输入：采集 -> 推理
+  FrameMailbox<InferenceFrame> _outputs;  // 推理结果：推理 -> 采集
 
-  std::mutex _mutex;
-  std::condition_variable cond_;
+  /**
+   * @brief V4L2缓存深度下限：信箱每个槽位可各持有一帧零拷贝图像，另需一帧在驱动中采集
+   *
+   */
+  static CaptureParams leaseParams(CaptureParams params)
+  {
+    int buffersMin = FrameMailbox<DetectionResult>::SLOTS + 2;
+    if (params.v4l2 && params.buffers < buffersMin)
+    {
+      std::cout << "V4L2 buffers " << params.buffers << " -> " << buffersMin << std::endl;
+      params.buffers = buffersMin;
+    }
+    return params;
+  }
 
-  std::unique_ptr<std::thread> _thread;
+  std::unique_ptr<std::thread> _thread;          // 采集线程
+  std::unique_ptr<std::thread> _threadInference; // 推理线程
 
   std::shared_ptr<Capture> _capture;
   std::shared_ptr<Predictor> _predictor;
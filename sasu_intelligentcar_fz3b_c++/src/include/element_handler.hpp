@@ -0,0 +1,117 @@
+#pragma once
+
+#include "predict_result.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 赛道元素处理表项：元素识别与路径规划及其触发条件、耗时统计
+ *
+ * 触发条件（基础赛道下调用的前提）：任一触发类别出现 || 几何条件成立 || 模块非空闲；
+ * 条件不成立时模块调用必然无动作并返回false，直接跳过
+ * @note 回调捕获所属流水线，表项随流水线初始化，不可拷贝到其他对象
+ */
+struct ElementHandler
+{
+  int roadType = 0;                 // 元素对应的赛道类型（RoadType）
+  std::string name;                 // 元素名称（统计输出）
+  std::function<bool()> enable;     // 元素使能（配置参数/全局状态）
+  std::vector<LabelId> labels;      // 触发类别：任一出现
+  std::function<bool()> geometry;   // 几何触发条件（可空）
+  std::function<bool()> busy;       // 模块状态机非空闲：计数/处理中需逐帧执行（可空）
+  std::function<bool()> run;        // 识别与路径规划：true-元素处理中
+  std::function<void()> enter;      // 由基础赛道进入元素（蜂鸣器提醒等，可空）
+  std::function<void(cv::Mat &)> draw; // 调试绘图（可空）
+
+  // 基础赛道下可与相邻的并行表项同时执行：只读赛道边缘/检测结果，只改写模块自身状态
+  bool parallel = false;
+  std::function<void()> save;    // 模块状态快照（并行执行前）
+  std::function<void()> restore; // 回滚：串行执行时不会轮到的表项
+
+  uint64_t runs = 0;    // 执行次数
+  uint64_t skips = 0;   // 触发条件不成立的跳过次数
+  double timeTotal = 0; // 累计耗时（ms）
+  double timeMax = 0;   // 最大耗时（ms）
+  double timeLast = 0;  // 最近一次耗时（ms）
+  int profileStage = -1; // 分阶段计时序号（首次执行时注册）
+
+  /**
+   * @brief 触发条件检查（基础赛道）
+   *
+   */
+  bool triggered(const PredictIndex &predicts) const
+  {
+    for (int i = 0; i < labels.size(); i++)
+    {
+      if (predicts.has(labels[i]))
+        return true;
+    }
+    return (geometry && geometry()) || (busy && busy());
+  }
+
+  /**
+   * @brief 执行并计时
+   *
+   */
+  bool execute(void)
+  {
+    if (profileStage < 0)
+      profileStage = Profiler::instance().stage("elem." + name);
+    ProfileScope scope(profileStage);
+    auto start = std::chrono::steady_clock::now();
+    bool result = run();
+    timeLast = std::chrono::duration<double, std::milli>(
+                   std::chrono::steady_clock::now() - start)
+                   .count();
+    timeTotal += timeLast;
+    timeMax = std::max(timeMax, timeLast);
+    runs++;
+    return result;
+  }
+
+  /**
+   * @brief 并行执行使能：以模块对象的拷贝作为状态快照（拷贝赋值复用容器内存）
+   *
+   */
+  template <typename T>
+  void parallelEnable(T &module)
+  {
+    std::shared_ptr<T> snapshot = std::make_shared<T>();
+    parallel = true;
+    save = [&module, snapshot] { *snapshot = module; };
+    restore = [&module, snapshot] { module = *snapshot; };
+  }
+
+  double timeMean(void) const { return runs ? timeTotal / runs : 0; }
+};
+
+/**
+ * @brief 元素处理耗时统计输出
+ *
+ * @param frames 统计区间内的帧数（计算每帧平均耗时）
+ */
+inline void printElementTiming(const std::vector<ElementHandler> &elements, uint64_t frames)
+{
+  std::ios format(nullptr);
+  format.copyfmt(std::cout); // 恢复输出格式
+  std::cout << "element    runs   skips  mean(ms)  max(ms)  ms/frame" << std::endl;
+  for (int i = 0; i < elements.size(); i++)
+  {
+    const ElementHandler &element = elements[i];
+    std::cout << std::left << std::setw(10) << element.name << std::right
+              << std::setw(6) << element.runs << std::setw(8) << element.skips
+              << std::fixed << std::setprecision(3) << std::setw(10)
+              << element.timeMean() << std::setw(9) << element.timeMax
+              << std::setw(10) << (frames ? element.timeTotal / frames : 0)
+              << std::endl;
+  }
+  std::cout.copyfmt(format);
+}
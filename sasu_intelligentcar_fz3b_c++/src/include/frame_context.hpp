@@ -0,0 +1,40 @@
+#pragma once
+
+#include "predict_result.hpp"
+#include <cstdint>
+#include <opencv2/opencv.hpp>
+
+/**
+ * @brief 单帧共享数据：每帧构建一次，以常量引用传给所有元素识别模块
+ *
+ * 包含二值图像、按类别分组的AI检测结果与帧时间；模块只读取，不拷贝
+ * @note 赛道边缘（TrackRecognition）会被各模块的路径规划改写，仍以独立的非常量引用传递
+ *       不预计算IPM俯视坐标：各模块只在元素激活时投影2~3个点，且投影的是本模块截取/改写后的边缘，
+ *       每帧整条边缘投影既用不上也更耗时（ipm.homography按点调用即可）
+ */
+struct FrameContext
+{
+  cv::Mat imageBinary;  // 二值化图像（与流水线共享数据，不拷贝）
+  PredictIndex predicts; // AI检测结果（按类别分组）
+  bool predictsFresh = true; // 新的推理结果（false：推理慢于采集，沿用上次推理的结果）
+  double time = 0;       // 帧时间（ms）
+  uint64_t frameId = 0;  // 帧序号
+
+  /**
+   * @brief 构建本帧数据
+   *
+   * @param binary 二值化图像
+   * @param results AI检测结果
+   * @param timeNow 帧时间（ms）
+   * @param fresh 新的推理结果：标志防抖计数只在新结果时累计，检测框（锥桶等）每帧可用
+   */
+  void build(const cv::Mat &binary, const std::vector<PredictResult> &results, double timeNow,
+             bool fresh = true)
+  {
+    imageBinary = binary;
+    predicts.build(results);
+    predictsFresh = fresh;
+    time = timeNow;
+    frameId++;
+  }
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+/**
+ * @brief 单生产者/单消费者的最新帧信箱（无锁三缓冲）
+ *
+ * 三个预分配槽位：生产者独占back，消费者独占front，middle为最近一次发布的帧
+ * 发布/读取均为一次原子交换，双方互不阻塞；生产者只会覆盖middle中未被读取的旧帧
+ * @note 消费者取得的槽位在下一次take()之前不会被生产者改写
+ */
+template <typename T>
+class FrameMailbox
+{
+public:
+  static constexpr int SLOTS = 3; // 槽位数：消费者/生产者/中转各一个
+
+  FrameMailbox()
+  {
+    for (int i = 0; i < SLOTS; i++)
+      _slots[i] = std::make_shared<T>();
+  }
+
+  /**
+   * @brief 生产者：当前可写入的槽位
+   *
+   */
+  std::shared_ptr<T> &back() { return _slots[_back]; }
+
+  /**
+   * @brief 生产者：发布back槽位，并换回一个空闲槽位
+   *
+   */
+  void publish()
+  {
+    uint8_t last = _middle.exchange(_back | FRESH, std::memory_order_acq_rel);
+    if (last & FRESH) // 上一帧未被读取即被覆盖
+      _dropped.fetch_add(1, std::memory_order_relaxed);
+    _back = last & INDEX;
+    _published.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief 消费者：取最新的帧
+   *
+   * @param wait true：等待新帧；false：无新帧时返回上一次取得的帧（首帧前仍等待）
+   * @return std::shared_ptr<T>& 最新帧槽位
+   */
+  std::shared_ptr<T> &take(bool wait = true)
+  {
+    int spins = 0;
+    while (!(_middle.load(std::memory_order_acquire) & FRESH))
+    {
+      if (!wait && _consumed.load(std::memory_order_relaxed))
+      {
+        _repeated.fetch_add(1, std::memory_order_relaxed);
+        return _slots[_front];
+      }
+      if (++spins < 64) // 新帧通常很快到达：先让出CPU，再短暂休眠
+        std::this_thread::yield();
+      else
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    _front = _middle.exchange(_front, std::memory_order_acq_rel) & INDEX;
+    _consumed.fetch_add(1, std::memory_order_relaxed);
+    return _slots[_front];
+  }
+
+  uint64_t published() { return _published.load(std::memory_order_relaxed); } // 发布帧数
+  uint64_t dropped() { return _dropped.load(std::memory_order_relaxed); }     // 未被读取即被覆盖的帧数
+  uint64_t repeated() { return _repeated.load(std::memory_order_relaxed); }   // 无新帧时重复返回旧帧的次数
+  uint64_t consumed() { return _consumed.load(std::memory_order_relaxed); }   // 读取的新帧数
+
+private:
+  static constexpr uint8_t INDEX = 0x03; // 槽位序号
+  static constexpr uint8_t FRESH = 0x04; // middle为未读取的新帧
+
+  std::shared_ptr<T> _slots[SLOTS];
+  uint8_t _back = 0;                  // 生产者独占
+  std::atomic<uint8_t> _middle{1};    // 最近一次发布（序号|FRESH）
+  uint8_t _front = 2;                 // 消费者独占
+  std::atomic<uint64_t> _published{0};
+  std::atomic<uint64_t> _consumed{0};
+  std::atomic<uint64_t> _dropped{0};
+  std::atomic<uint64_t> _repeated{0};
+};
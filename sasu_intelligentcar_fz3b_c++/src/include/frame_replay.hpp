@@ -0,0 +1,118 @@
+#pragma once
+
+#include "frame_source.hpp"
+#include "../src/icar_pipeline.cpp"
+#include <chrono>
+#include <functional>
+#include <map>
+#include <vector>
+
+/**
+ * @brief 单帧控制输出：离线回放/回归检查/流水线对比共用
+ *
+ */
+struct FrameOutput
+{
+  int roadType = 0;       // 赛道类型
+  int controlCenter = 0;  // 控制中心
+  int servoPwm = 0;       // 舵机PWM
+  float motorSpeed = 0;   // 规划车速
+  float controlSpeed = 0; // 下发速度（0：未下发）
+  bool finish = false;    // 入库完成/冲出赛道
+
+  /**
+   * @brief 读取流程本帧的输出
+   *
+   */
+  static FrameOutput from(IcarPipeline &pipeline)
+  {
+    FrameOutput output;
+    output.roadType = pipeline.roadType;
+    output.controlCenter = pipeline.controlCenterCal.controlCenter;
+    output.servoPwm = pipeline.motionController.servoPwm;
+    output.motorSpeed = pipeline.motionController.motorSpeed;
+    output.controlSpeed = pipeline.controlEnable ? pipeline.controlSpeed : 0;
+    output.finish = pipeline.finish;
+    return output;
+  }
+
+  bool operator!=(const FrameOutput &other) const
+  {
+    return roadType != other.roadType || controlCenter != other.controlCenter ||
+           servoPwm != other.servoPwm || motorSpeed != other.motorSpeed ||
+           controlSpeed != other.controlSpeed || finish != other.finish;
+  }
+
+  static const char *header() { return "frame,roadType,controlCenter,servoPwm,motorSpeed,controlSpeed"; }
+
+  /**
+   * @brief CSV行（格式同header()）
+   *
+   */
+  void write(std::ostream &out, int frame) const
+  {
+    out << frame << "," << roadType << "," << controlCenter << "," << servoPwm << ","
+        << motorSpeed << "," << controlSpeed << std::endl;
+  }
+};
+
+/**
+ * @brief 回放初始化：读取配置，不显示、不存图
+ *
+ */
+inline void replayInit(IcarPipeline &pipeline)
+{
+  pipeline.motionController.loadParams();
+  pipeline.motionController.params.debug = false;
+  pipeline.motionController.params.saveImage = false;
+  pipeline.init();
+}
+
+/**
+ * @brief 录制序列回放：逐帧驱动完整识别与控制流程，直到序列结束或入库完成/冲出赛道
+ *
+ * @param source 已打开的录制帧
+ * @param pipeline 已初始化的流程（replayInit）
+ * @param predicts AI结果文件（帧序号 -> 检测结果）；为空且回放运行日志时取日志中记录的结果
+ * @param fps 帧率：帧时间按帧率推算（运行日志取记录的帧时间）
+ * @param outputs 输出：逐帧控制输出
+ * @param onFrame 每帧处理后回调（可选）：帧序号
+ * @return double 流程处理总耗时（ms，不含读帧）
+ * @note 与比赛模式一致：第0帧发车；相同输入的输出完全一致
+ */
+inline double replayRun(FrameSource &source, IcarPipeline &pipeline,
+                        std::map<int, std::vector<PredictResult>> &predicts, double fps,
+                        std::vector<FrameOutput> &outputs,
+                        std::function<void(int)> onFrame = nullptr)
+{
+  pipeline.start(source.isRunLog() ? source.timeStart() : 0);
+  outputs.clear();
+  cv::Mat frame;
+  double timeProcess = 0;
+  std::vector<PredictResult> results;
+  while (source.read(frame))
+  {
+    int counter = outputs.size();
+    if (frame.cols != COLSIMAGE || frame.rows != ROWSIMAGE)
+      cv::resize(frame, frame, cv::Size(COLSIMAGE, ROWSIMAGE));
+    auto it = predicts.find(counter);
+    results.clear(); // 元素识别可能改写检测结果：每帧重新拷贝
+    if (it != predicts.end())
+      results = it->second;
+    else if (source.isRunLog() && predicts.empty())
+      results = source.record.predicts;
+    double time = source.isRunLog() ? source.record.time : counter * 1000.0 / fps;
+    bool fresh = !source.isRunLog() || !predicts.empty() || source.record.predictsFresh;
+
+    auto start = std::chrono::steady_clock::now();
+    pipeline.process(frame, results, time, fresh);
+    timeProcess += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    outputs.push_back(FrameOutput::from(pipeline));
+    if (onFrame)
+      onFrame(counter);
+    if (pipeline.finish) // 入库完成/冲出赛道
+      break;
+  }
+  return timeProcess;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "run_log.hpp"
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 录制帧读取：运行日志、视频文件或图像文件夹（按文件名排序）
+ *
+ */
+class FrameSource
+{
+public:
+  RunLogFrame record; // 运行日志：当前帧记录
+
+  bool open(std::string path)
+  {
+    if (RunLogReader::isRunLog(path))
+    {
+      runLog = log.open(path);
+      return runLog;
+    }
+    if (capture.open(path) && capture.isOpened())
+      return true;
+    cv::glob(path, imagesPath, false);
+    std::sort(imagesPath.begin(), imagesPath.end());
+    return !imagesPath.empty();
+  }
+
+  bool read(cv::Mat &frame)
+  {
+    if (runLog)
+    {
+      if (!log.read(index++, record))
+        return false;
+      frame = record.image;
+      return true;
+    }
+    if (capture.isOpened())
+      return capture.read(frame);
+    while (index < imagesPath.size())
+    {
+      frame = cv::imread(imagesPath[index++]);
+      if (!frame.empty())
+        return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief 读取全部帧到内存（基准测试：计时前一次载入）
+   *
+   * @param path 运行日志/视频文件/图像文件夹
+   * @param frames 输出：追加读取的帧（深拷贝，运行日志的图像不再指向映射内存）
+   * @return int 读取的帧数
+   */
+  static int load(const std::string &path, std::vector<cv::Mat> &frames)
+  {
+    FrameSource source;
+    cv::Mat frame;
+    int count = 0;
+    if (source.open(path))
+    {
+      for (; source.read(frame); count++)
+        frames.push_back(frame.clone());
+    }
+    return count;
+  }
+
+  bool isRunLog() { return runLog; }
+  double timeStart() { return log.timeStart(); }
+
+private:
+  bool runLog = false;
+  RunLogReader log;
+  cv::VideoCapture capture;
+  std::vector<cv::String> imagesPath;
+  size_t index = 0;
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "model_config.hpp"
+#include "predict_result.hpp"
+#include <memory>
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @brief AI推理后端接口：Paddle Lite（FPGA）/ OpenCV DNN（CPU）/ 录制结果回放
+ *
+ */
+class InferenceBackend
+{
+public:
+  virtual ~InferenceBackend(){};
+
+  /**
+   * @brief 后端初始化
+   *
+   * @param config 模型配置
+   * @return int 0：成功
+   */
+  virtual int init(std::shared_ptr<ModelConfig> &config) = 0;
+
+  /**
+   * @brief 单帧推理
+   *
+   * @param frame BGR图像
+   * @param results 输出：检测结果（未转换标签），复用调用者的内存
+   * @param frameId 图像帧序号（采集顺序，从1开始；录制回放后端按其查找结果）
+   */
+  virtual void run(cv::Mat &frame, std::vector<PredictResult> &results, uint64_t frameId) = 0;
+
+  virtual std::string name() = 0;
+
+protected:
+  /**
+   * @brief SSD/YOLO检测输出解析：每个目标6个数 [类别, 置信度, x1, y1, x2, y2]
+   *
+   * @param data 输出数据
+   * @param size 目标数
+   * @param config 模型配置
+   * @param frame 输入图像（SSD输出为归一化坐标）
+   * @param results 输出：检测结果
+   */
+  static void parseDetections(const float *data, int size,
+                              std::shared_ptr<ModelConfig> &config,
+                              cv::Mat &frame, std::vector<PredictResult> &results)
+  {
+    results.clear(); // 保留容量，稳态下不再分配
+    for (int i = 0; i < size; i++)
+    {
+      const float *item = data + i * 6;
+      float score = item[1];
+      if (score < config->threshold)
+      {
+        continue;
+      }
+      PredictResult r;
+      r.type = (int)item[0];
+      r.score = score;
+      if (config->is_yolo)
+      {
+        r.x = item[2];
+        r.y = item[3];
+        r.width = item[4] - r.x;
+        r.height = item[5] - r.y;
+      }
+      else
+      {
+        r.x = item[2] * frame.cols;
+        r.y = item[3] * frame.rows;
+        r.width = item[4] * frame.cols - r.x;
+        r.height = item[5] * frame.rows - r.y;
+      }
+      results.push_back(r);
+    }
+  }
+};
@@ -28,6 +28,11 @@ struct ModelConfig
   bool is_yolo;
   bool is_combined_model;
 
+  std::string backend;     // 推理后端：paddle / opencv / recorded
+  std::string onnx_file;   // OpenCV DNN后端：ONNX模型
+  std::string record_file; // 录制结果回放后端：检测结果文件
+  bool fused_preprocess;   // 预处理：融合缩放/通道交换/归一化/打包内核（默认false：Paddle图像预处理库/blobFromImage）
+
   std::vector<std::string> labels;
 
   void assert_check_file_exist(std::string fileName, std::string modelPath)
@@ -41,7 +46,8 @@ struct ModelConfig
       exit(-1);
     }
   }
-  ModelConfig(std::string model_path) : model_parent_dir(model_path + "/")
+  ModelConfig(std::string model_path, std::string backend_name = "")
+      : model_parent_dir(model_path + "/")
   {
 
     std::string json_config_path = model_parent_dir + "config.json";
@@ -95,6 +101,22 @@ struct ModelConfig
       }
     }
 
+    // 推理后端：参数优先，其次config.json，默认paddle
+    backend = "paddle";
+    if (value["backend"] != nullptr)
+      backend = value["backend"];
+    if (!backend_name.empty())
+      backend = backend_name;
+    onnx_file = model_parent_dir + "model.onnx";
+    if (value["onnx_file_name"] != nullptr)
+      onnx_file = model_parent_dir + value["onnx_file_name"].get<std::string>();
+    record_file = model_parent_dir + "detections.txt";
+    if (value["record_file_name"] != nullptr)
+      record_file = model_parent_dir + value["record_file_name"].get<std::string>();
+    fused_preprocess = false; // 默认沿用Paddle图像预处理库：config.json开启前先用normalize_benchmark与其逐帧比对
+    if (value["fused_preprocess"] != nullptr)
+      fused_preprocess = value["fused_preprocess"];
+
     if ((value["model_file_name"] != nullptr) &&
         (value["params_file_name"] != nullptr) &&
         (value["model_dir"] == nullptr))
@@ -116,7 +138,7 @@ struct ModelConfig
       params_file = "";
       model_file = "";
     }
-    else
+    else if (backend == "paddle")
     {
       std::cout
           << "json config Error !!!! \n combined_model: need params_file_name "
@@ -145,14 +167,17 @@ struct ModelConfig
       }
     }
 
-    if (is_combined_model)
-    {
-      assert_check_file_exist(value["model_file_name"], model_parent_dir);
-      assert_check_file_exist(value["params_file_name"], model_parent_dir);
-    }
-    else
+    if (backend == "paddle") // 其它后端不读取Paddle模型文件
     {
-      assert_check_file_exist(value["model_dir"], model_parent_dir);
+      if (is_combined_model)
+      {
+        assert_check_file_exist(value["model_file_name"], model_parent_dir);
+        assert_check_file_exist(value["params_file_name"], model_parent_dir);
+      }
+      else
+      {
+        assert_check_file_exist(value["model_dir"], model_parent_dir);
+      }
     }
 
     std::cout << "Model Config Init Success !!!" << std::endl;
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "inference_backend.hpp"
+#include "resize_normalize.hpp"
+#include <opencv2/dnn.hpp>
+
+/**
+ * @brief OpenCV DNN推理后端：CPU运行同一MobileNet-SSD（非EdgeBoard机器使用）
+ *
+ * @note OpenCV不能直接读取Paddle模型，需用paddle2onnx导出带NMS的ONNX模型，
+ *       输出与Paddle一致：[N, 6]（类别, 置信度, x1, y1, x2, y2）
+ */
+class OpenCVBackend : public InferenceBackend
+{
+private:
+  std::shared_ptr<ModelConfig> _model_config;
+  cv::dnn::Net _net;
+  cv::Mat _blob;          // 输入张量（复用）
+  ResizeNormalize _kernel; // 融合预处理内核
+
+public:
+  int init(std::shared_ptr<ModelConfig> &config) override
+  {
+    _model_config = config;
+    try
+    {
+      _net = cv::dnn::readNet(_model_config->onnx_file);
+    }
+    catch (const cv::Exception &e)
+    {
+      std::cout << "Error: OpenCV DNN load failed: " << e.what() << std::endl;
+      return -1;
+    }
+    if (_net.empty())
+    {
+      std::cout << "Error: OpenCV DNN load failed: " << _model_config->onnx_file
+                << std::endl;
+      return -1;
+    }
+    _net.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
+    _net.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+    _kernel.init(_model_config->input_width, _model_config->input_height,
+                 _model_config->means, _model_config->scales,
+                 _model_config->format == "RGB", ResizeNormalize::NCHW);
+    return 0;
+  }
+
+  void run(cv::Mat &inputFrame, std::vector<PredictResult> &results, uint64_t) override
+  {
+    if (_model_config->fused_preprocess)
+    {
+      int shape[] = {1, 3, _model_config->input_height, _model_config->input_width};
+      _blob.create(4, shape, CV_32F); // 尺寸不变时复用内存
+      _kernel.run(inputFrame, _blob.ptr<float>());
+    }
+    else // 归一化：(x - mean) * scale，三通道scale相同（config.json）
+      cv::dnn::blobFromImage(
+          inputFrame, _blob, _model_config->scales[0],
+          cv::Size(_model_config->input_width, _model_config->input_height),
+          cv::Scalar(_model_config->means[0], _model_config->means[1],
+                     _model_config->means[2]),
+          _model_config->format == "RGB", false);
+    _net.setInput(_blob);
+    cv::Mat output = _net.forward();
+
+    int size = output.total() / 6;
+    parseDetections(output.ptr<float>(), size, _model_config, inputFrame, results);
+  }
+
+  std::string name() override { return "opencv"; }
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "inference_backend.hpp"
+#include "preprocess.hpp"
+#include <paddle_api.h>
+
+/**
+ * @brief Paddle Lite推理后端：FPGA加速（EdgeBoard）
+ *
+ */
+class PaddleBackend : public InferenceBackend
+{
+private:
+  std::shared_ptr<ModelConfig> _model_config;
+  std::shared_ptr<PaddlePredictor> _predictor;
+  std::unique_ptr<Tensor> _input;     // 输入张量句柄（复用）
+  std::unique_ptr<Tensor> _img_shape; // YOLO输入尺寸张量句柄
+  FpgaPreprocess _preprocess;         // 预处理：复用上下文与暂存内存
+
+public:
+  int init(std::shared_ptr<ModelConfig> &config) override
+  {
+    _model_config = config;
+    std::vector<Place> valid_places({
+        Place{TARGET(kFPGA), PRECISION(kFP16), DATALAYOUT(kNHWC)},
+        Place{TARGET(kHost), PRECISION(kFloat)},
+        Place{TARGET(kARM), PRECISION(kFloat)},
+    });
+
+    paddle::lite_api::CxxConfig cxx_config;
+
+    if (_model_config->is_combined_model)
+    {
+      cxx_config.set_model_file(_model_config->model_file);
+      cxx_config.set_param_file(_model_config->params_file);
+    }
+    else
+    {
+      cxx_config.set_model_dir(_model_config->model_params_dir);
+    }
+
+    cxx_config.set_valid_places(valid_places);
+
+    _predictor = paddle::lite_api::CreatePaddlePredictor(cxx_config);
+    if (!_predictor)
+    {
+      std::cout << "Error: CreatePaddlePredictor Failed." << std::endl;
+      return -1;
+    }
+
+    // 输入张量形状固定：初始化时一次性设置，推理时只写入数据
+    _input = _predictor->GetInput(0);
+    _input->Resize(
+        {1, 3, _model_config->input_height, _model_config->input_width});
+    if (_model_config->is_yolo)
+    {
+      _img_shape = _predictor->GetInput(1);
+      _img_shape->Resize({1, 2});
+    }
+    _preprocess.init(_model_config);
+    return 0;
+  }
+
+  void run(cv::Mat &inputFrame, std::vector<PredictResult> &results, uint64_t) override
+  {
+    _preprocess.run(inputFrame, _input.get());
+
+    if (_model_config->is_yolo)
+    {
+      auto *img_shape_data = _img_shape->mutable_data<int32_t>();
+      img_shape_data[0] = inputFrame.rows;
+      img_shape_data[1] = inputFrame.cols;
+    }
+
+    _predictor->Run();
+
+    auto output = _predictor->GetOutput(0); // 输出形状随目标数变化，每帧获取
+    const float *result_data = output->data<float>();
+    int size = output->shape()[0];
+    parseDetections(result_data, size, _model_config, inputFrame, results);
+  }
+
+  std::string name() override { return "paddle"; }
+
+  Tensor *input() { return _input.get(); }             // 模型输入张量
+  FpgaPreprocess &preprocess() { return _preprocess; } // 预处理阶段
+};
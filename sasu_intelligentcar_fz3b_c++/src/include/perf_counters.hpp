@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <string>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define PERF_COUNTERS 6 // 周期/指令/缓存访问/缓存未命中/分支/分支预测失败
+#define PERF_VALUES (PERF_COUNTERS + 2) // 计数器读数 + 组的启用/实际计数时间（ns）
+
+/**
+ * @brief 硬件性能计数器：当前线程的一组perf_event计数器（用户态），一次read()读取整组
+ *
+ * 计数器组：周期为组长，其余为成员；平台不支持的成员跳过，对应读数为0
+ * 硬件计数器不足时（如仅4个通用计数器）内核分时复用整组，TimeRunning < TimeEnabled，
+ * 读数只覆盖实际计数的时间，统计时按 TimeEnabled / TimeRunning 缩放
+ * @note 需内核支持perf_event且perf_event_paranoid允许（<=2：仅用户态计数），容器内通常不可用
+ */
+class PerfCounters
+{
+public:
+  enum Counter
+  {
+    Cycles = 0,
+    Instructions,
+    CacheReferences,
+    CacheMisses,
+    Branches,
+    BranchMisses,
+    TimeEnabled, // 组启用时间（ns）
+    TimeRunning, // 组实际计数时间（ns）
+  };
+
+  ~PerfCounters() { close(); }
+
+  /**
+   * @brief 打开并启动当前线程的计数器组
+   *
+   * @return false 不可用（error()为原因）
+   */
+  bool open()
+  {
+    const uint64_t configs[PERF_COUNTERS] = {
+        PERF_COUNT_HW_CPU_CYCLES,       PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES};
+    close();
+    _members = 0;
+    for (int i = 0; i < PERF_COUNTERS; i++)
+    {
+      struct perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = configs[i];
+      attr.disabled = _leader < 0; // 组长启动时整组计数
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                         PERF_FORMAT_TOTAL_TIME_RUNNING;
+      int fd = syscall(__NR_perf_event_open, &attr, 0, -1, _leader, 0);
+      if (fd < 0)
+      {
+        if (_leader < 0) // 周期计数不可用：整组不可用
+        {
+          _error = std::string("perf_event_open: ") + strerror(errno);
+          return false;
+        }
+        continue;
+      }
+      if (_leader < 0)
+        _leader = fd;
+      _fds[i] = fd;
+      _index[_members++] = i;
+    }
+    ioctl(_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+  }
+
+  /**
+   * @brief 读取整组累计值（未缩放）及组的启用/实际计数时间
+   *
+   */
+  bool read(uint64_t values[PERF_VALUES])
+  {
+    struct
+    {
+      uint64_t count;
+      uint64_t timeEnabled;
+      uint64_t timeRunning;
+      uint64_t values[PERF_COUNTERS];
+    } group;
+    if (_leader < 0 || ::read(_leader, &group, sizeof(group)) < (ssize_t)(3 * sizeof(uint64_t)))
+      return false;
+    memset(values, 0, sizeof(uint64_t) * PERF_VALUES);
+    for (int i = 0; i < group.count && i < _members; i++)
+      values[_index[i]] = group.values[i];
+    values[TimeEnabled] = group.timeEnabled;
+    values[TimeRunning] = group.timeRunning;
+    return true;
+  }
+
+  void close()
+  {
+    for (int i = 0; i < PERF_COUNTERS; i++)
+    {
+      if (_fds[i] >= 0)
+        ::close(_fds[i]);
+      _fds[i] = -1;
+    }
+    _leader = -1;
+  }
+
+  bool isOpen() { return _leader >= 0; }
+  std::string error() { return _error; }
+
+private:
+  int _leader = -1;
+  int _fds[PERF_COUNTERS] = {-1, -1, -1, -1, -1, -1};
+  int _index[PERF_COUNTERS] = {}; // 组内第i个成员对应的计数器
+  int _members = 0;
+  std::string _error;
+};
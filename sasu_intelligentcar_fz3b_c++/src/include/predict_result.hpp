@@ -0,0 +1,46 @@
+#pragma once
+
+#include "label_id.hpp"
+#include <string>
+#include <vector>
+
+/**
+ * @brief AI检测结果（与推理框架无关，供元素识别与离线回放使用）
+ *
+ */
+struct PredictResult
+{
+  int type;
+  std::string label;
+  float score;
+  int x;
+  int y;
+  int width;
+  int height;
+};
+
+/**
+ * @brief 单帧AI检测结果按类别分组：元素识别直接取所需类别的目标，不再逐个比较标签字符串
+ *
+ * @note 每帧build()一次；类内保持检测结果的原始顺序，分组容器跨帧复用
+ */
+class PredictIndex
+{
+public:
+  void build(const std::vector<PredictResult> &predicts)
+  {
+    for (int i = 0; i < LABEL_COUNT; i++)
+      _groups[i].clear();
+    for (int i = 0; i < predicts.size(); i++)
+    {
+      if (predicts[i].type >= 0 && predicts[i].type < LABEL_COUNT)
+        _groups[predicts[i].type].push_back(predicts[i]);
+    }
+  }
+
+  const std::vector<PredictResult> &operator[](LabelId id) const { return _groups[id]; }
+  bool has(LabelId id) const { return !_groups[id].empty(); }
+
+private:
+  std::vector<PredictResult> _groups[LABEL_COUNT];
+};
@@ -1,34 +1,44 @@
 #pragma once
 
+#include "inference_backend.hpp"
 #include "model_config.hpp"
-#include "preprocess.hpp"
-#include <paddle_api.h>
-
-struct PredictResult
-{
-  int type;
-  std::string label;
-  float score;
-  int x;
-  int y;
-  int width;
-  int height;
-};
+#include "opencv_backend.hpp"
+#include "predict_result.hpp"
+#include "profiler.hpp"
+#include "recorded_backend.hpp"
+#include "stop_watch.hpp"
+#ifdef PADDLE_LITE_ENABLE
+#include "paddle_backend.hpp"
+#endif
 
 class Predictor
 {
 private:
   std::string _config_path;
+  std::string _backend_name;
   std::shared_ptr<ModelConfig> _model_config;
-  std::shared_ptr<PaddlePredictor> _predictor;
+  std::shared_ptr<InferenceBackend> _backend;
+
+  // 推理耗时统计（ms）
+  uint64_t _latency_count = 0;
+  double _latency_total = 0;
+  double _latency_max = 0;
+  double _latency_last = 0;
 
 public:
-  Predictor(std::string config_path) : _config_path(config_path){};
+  /**
+   * @brief 构造函数
+   *
+   * @param config_path 模型路径
+   * @param backend 推理后端：paddle / opencv / recorded（空：使用config.json中的backend，默认paddle）
+   */
+  Predictor(std::string config_path, std::string backend = "")
+      : _config_path(config_path), _backend_name(backend){};
   ~Predictor(){};
 
   int init()
   {
-    _model_config = std::make_shared<ModelConfig>(_config_path);
+    _model_config = std::make_shared<ModelConfig>(_config_path, _backend_name);
     if (_model_config == nullptr)
     {
       std::cout << "Create Model config failed, config path: " << _config_path
@@ -36,91 +46,78 @@ public:
 
       return -1;
     }
-    std::vector<Place> valid_places({
-        Place{TARGET(kFPGA), PRECISION(kFP16), DATALAYOUT(kNHWC)},
-        Place{TARGET(kHost), PRECISION(kFloat)},
-        Place{TARGET(kARM), PRECISION(kFloat)},
-    });
-
-    paddle::lite_api::CxxConfig config;
-
-    if (_model_config->is_combined_model)
+    if (!labelTableCheck(_model_config->labels)) // 元素识别按编译时类别ID取目标
     {
-      config.set_model_file(_model_config->model_file);
-      config.set_param_file(_model_config->params_file);
-    }
-    else
-    {
-      config.set_model_dir(_model_config->model_params_dir);
+      std::cout << "Error: Model labels do not match label_id.hpp, re-run cmake "
+                   "after changing label_list.txt."
+                << std::endl;
+      return -1;
     }
 
-    config.set_valid_places(valid_places);
-
-    _predictor = paddle::lite_api::CreatePaddlePredictor(config);
-    if (!_predictor)
+    if (_model_config->backend == "opencv")
+      _backend = std::make_shared<OpenCVBackend>();
+    else if (_model_config->backend == "recorded")
+      _backend = std::make_shared<RecordedBackend>();
+#ifdef PADDLE_LITE_ENABLE
+    else if (_model_config->backend == "paddle")
+      _backend = std::make_shared<PaddleBackend>();
+#endif
+    if (_backend == nullptr)
     {
-      std::cout << "Error: CreatePaddlePredictor Failed." << std::endl;
+      std::cout << "Error: Inference backend [" << _model_config->backend
+                << "] not supported." << std::endl;
       return -1;
     }
-    std::cout << "Predictor Init Success !!!" << std::endl;
+    if (_backend->init(_model_config) != 0)
+      return -1;
+
+    std::cout << "Predictor Init Success !!! [" << _backend->name() << "]"
+              << std::endl;
     return 0;
   };
 
-  std::vector<PredictResult> run(cv::Mat &inputFrame)
+  /**
+   * @brief 单帧推理
+   *
+   * @param inputFrame BGR图像
+   * @param results 输出：检测结果，跨帧复用同一容器时稳态下无内存分配
+   * @param frameId 图像帧序号（从1开始，0：无序号，录制回放后端无结果）
+   */
+  void run(cv::Mat &inputFrame, std::vector<PredictResult> &results, uint64_t frameId = 0)
   {
-    std::vector<PredictResult> predict_ret;
-
-    auto input = _predictor->GetInput(0);
-    input->Resize(
-        {1, 3, _model_config->input_height, _model_config->input_width});
-
-    fpga_preprocess(inputFrame, _model_config, input);
-
-    if (_model_config->is_yolo)
-    {
-      auto img_shape = _predictor->GetInput(1);
-      img_shape->Resize({1, 2});
-      auto *img_shape_data = img_shape->mutable_data<int32_t>();
-      img_shape_data[0] = inputFrame.rows;
-      img_shape_data[1] = inputFrame.cols;
-    }
-
-    _predictor->Run();
-
-    auto output = _predictor->GetOutput(0);
-    float *result_data = output->mutable_data<float>();
-    int size = output->shape()[0];
+    PROFILE_SCOPE("predictor");
+    StopWatch stop_watch;
+    stop_watch.tic();
+    _backend->run(inputFrame, results, frameId);
+    _latency_last = stop_watch.toc();
+    _latency_total += _latency_last;
+    _latency_max = std::max(_latency_max, _latency_last);
+    _latency_count++;
+  };
 
-    for (int i = 0; i < size; i++)
-    {
-      float *data = result_data + i * 6;
-      float score = data[1];
-      if (score < _model_config->threshold)
-      {
-        continue;
-      }
-      PredictResult r;
-      r.type = (int)data[0];
-      r.score = score;
-      if (_model_config->is_yolo)
-      {
-        r.x = data[2];
-        r.y = data[3];
-        r.width = data[4] - r.x;
-        r.height = data[5] - r.y;
-      }
-      else
-      {
-        r.x = data[2] * inputFrame.cols;
-        r.y = data[3] * inputFrame.rows;
-        r.width = data[4] * inputFrame.cols - r.x;
-        r.height = data[5] * inputFrame.rows - r.y;
-      }
-      predict_ret.push_back(r);
-    }
+  std::vector<PredictResult> run(cv::Mat &inputFrame, uint64_t frameId = 0)
+  {
+    std::vector<PredictResult> predict_ret;
+    run(inputFrame, predict_ret, frameId);
     return predict_ret;
   };
 
+  std::string backendName() { return _backend->name(); }
+  double latencyLast() { return _latency_last; } // 最近一次推理耗时（ms）
+  double latencyMean() { return _latency_count ? _latency_total / _latency_count : 0; }
+  double latencyMax() { return _latency_max; }
+
+  /**
+   * @brief 推理耗时统计输出
+   *
+   */
+  void printLatency()
+  {
+    std::cout << "Predictor [" << _backend->name() << "] runs: " << _latency_count
+              << " mean: " << latencyMean() << "ms max: " << _latency_max
+              << "ms" << std::endl;
+  }
+
   void render(cv::Mat &inputFrame, std::vector<PredictResult> &results)
   {
     for (int i = 0; i < results.size(); ++i)
@@ -7,6 +7,7 @@
 #include <paddle_api.h>
 #include <paddle_image_preprocess.h>
 #include "capture.hpp"
+#include "resize_normalize.hpp"
 
 using namespace std;
 using namespace cv;
@@ -19,52 +20,87 @@ typedef paddle::lite::utils::cv::TransParam TransParam;
 typedef paddle::lite::utils::cv::ImageFormat ImageFormat;
 typedef paddle::lite::utils::cv::ImagePreprocess Preprocess;
 
-// AI 模型图像预处理函数，这个函数有predictor类接口进行调用
-// 用户不必直接使用它
-inline void fpga_preprocess(cv::Mat img, std::shared_ptr<ModelConfig> &config,
-                            std::unique_ptr<Tensor> &tensor)
+/**
+ * @brief AI 模型图像预处理（FPGA）：BGR图像 -> 归一化NHWC输入张量
+ *
+ * 由推理后端持有，跨帧复用预处理上下文与暂存内存，稳态下每帧无堆内存分配：
+ * 默认使用Paddle图像预处理库：连续图像直接作为输入（不拷贝），仅非连续/超大图像经过暂存内存；
+ * config.json开启fused_preprocess时使用融合内核，缩放、通道交换、归一化一次遍历直接写入输入张量
+ * @note 这个类由predictor类接口进行调用，用户不必直接使用它
+ */
+class FpgaPreprocess
 {
+public:
+  void init(std::shared_ptr<ModelConfig> &config)
+  {
+    _config = config;
+    _preprocess.reset();
+    _kernel.init(_config->input_width, _config->input_height, _config->means,
+                 _config->scales, _config->format == "RGB", ResizeNormalize::NHWC);
+  }
 
-    int width = img.cols;
-    int height = img.rows;
+  /**
+   * @brief 单帧预处理
+   *
+   * @param img BGR图像（CV_8UC3）
+   * @param tensor 模型输入张量（已Resize为1x3xHxW）
+   */
+  void run(cv::Mat &img, Tensor *tensor)
+  {
+    if (_config->fused_preprocess)
+    {
+      _kernel.run(img, tensor->mutable_data<float>());
+      return;
+    }
 
-    if (height > 1080)
+    cv::Mat *input = &img;
+    if (img.rows > 1080)
     {
-        float fx = img.cols / config->input_width;
-        float fy = img.rows / config->input_height;
-        Mat resize_mat;
-        resize(img, resize_mat, Size(config->input_width, config->input_height), fx,
-               fy);
-        img = resize_mat;
-        height = img.rows;
-        width = img.cols;
+      cv::resize(img, _resized, cv::Size(_config->input_width, _config->input_height)); // 尺寸不变时复用内存
+      input = &_resized;
     }
 
-    uint8_t *src = (uint8_t *)malloc(3 * width * height);
-    if (img.isContinuous())
+    const uint8_t *src = input->data;
+    if (!input->isContinuous()) // ROI等非连续图像：逐行拷贝到暂存内存
     {
-        memcpy(src, img.data, 3 * width * height * sizeof(uint8_t));
+      size_t row = input->cols * 3;
+      if (_staging.size() < row * input->rows)
+      {
+        _staging.resize(row * input->rows);
+        _reallocs++;
+      }
+      for (int i = 0; i < input->rows; ++i)
+        memcpy(_staging.data() + i * row, input->ptr<uint8_t>(i), row);
+      src = _staging.data();
     }
-    else
+
+    if (!_preprocess || _width != input->cols || _height != input->rows) // 输入尺寸变化时重建上下文
     {
-        uint8_t *img_data = img.data;
-        for (int i = 0; i < img.rows; ++i)
-        {
-            src = src + i * (width * 3);
-            img_data = img_data + i * (width * 3);
-            memcpy(src, img_data, width * 3 * sizeof(uint8_t));
-        }
+      TransParam tparam;
+      tparam.ih = input->rows;
+      tparam.iw = input->cols;
+      tparam.oh = _config->input_height;
+      tparam.ow = _config->input_width;
+      _preprocess.reset(new Preprocess(
+          ImageFormat::BGR,
+          _config->format == "RGB" ? ImageFormat::RGB : ImageFormat::BGR, tparam));
+      _width = input->cols;
+      _height = input->rows;
+      _reallocs++;
     }
-    TransParam tparam;
-    tparam.ih = img.rows;
-    tparam.iw = img.cols;
-    tparam.oh = config->input_height;
-    tparam.ow = config->input_width;
+    _preprocess->image_to_tensor(src, tensor, LayoutType::kNHWC,
+                                 _config->means, _config->scales);
+  }
+
+  uint64_t reallocs() { return _reallocs; } // 上下文重建/暂存内存扩容次数（稳态应不再增长）
 
-    Preprocess preprocess(
-        ImageFormat::BGR,
-        config->format == "RGB" ? ImageFormat::RGB : ImageFormat::BGR, tparam);
-    preprocess.image_to_tensor(src, tensor.get(), LayoutType::kNHWC,
-                               config->means, config->scales);
-    free(src);
-}
+private:
+  std::shared_ptr<ModelConfig> _config;
+  ResizeNormalize _kernel;                  // 融合预处理内核
+  std::unique_ptr<Preprocess> _preprocess; // 预处理上下文（复用）
+  std::vector<uint8_t> _staging;           // 非连续图像暂存内存（复用）
+  cv::Mat _resized;                        // 超大图像缩放结果（复用）
+  int _width = 0;
+  int _height = 0;
+  uint64_t _reallocs = 0;
+};
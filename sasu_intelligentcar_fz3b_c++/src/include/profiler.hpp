@@ -0,0 +1,496 @@
+#pragma once
+
+#include "perf_counters.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <pthread.h>
+#include <string>
+#include <vector>
+
+#define PROFILE_STAGES 64  // 最大计时阶段数
+#define PROFILE_RING 8192  // 每线程环形缓冲记录数（2的幂）：百分位统计窗口
+
+/**
+ * @brief 单次计时记录（字段为relaxed原子量：统计线程读取时不构成数据竞争）
+ *
+ */
+struct ProfileSample
+{
+  std::atomic<uint32_t> stage{0};
+  std::atomic<uint64_t> start{0};    // 开始时刻（ns，steady_clock）
+  std::atomic<uint64_t> duration{0}; // 耗时（ns）
+};
+
+/**
+ * @brief 线程私有的计时环形缓冲：本线程写入（无锁、无分配），统计线程读取最近的记录
+ *
+ * 缓冲写满后覆盖最旧的记录；各阶段的累计次数与最大值不受覆盖影响
+ */
+class ProfileRing
+{
+public:
+  std::string thread; // 线程名
+
+  void push(int stage, uint64_t start, uint64_t duration)
+  {
+    uint64_t head = _head.load(std::memory_order_relaxed);
+    ProfileSample &sample = _samples[head & (PROFILE_RING - 1)];
+    sample.stage.store(stage, std::memory_order_relaxed);
+    sample.start.store(start, std::memory_order_relaxed);
+    sample.duration.store(duration, std::memory_order_relaxed);
+    _head.store(head + 1, std::memory_order_release);
+
+    _count[stage].store(_count[stage].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (duration > _max[stage].load(std::memory_order_relaxed))
+      _max[stage].store(duration, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief 读取缓冲中的记录（按写入顺序），丢弃读取期间可能被覆盖的记录
+   *
+   */
+  void snapshot(std::vector<uint32_t> &stages, std::vector<uint64_t> &starts,
+                std::vector<uint64_t> &durations)
+  {
+    uint64_t head = _head.load(std::memory_order_acquire);
+    uint64_t begin = head > PROFILE_RING ? head - PROFILE_RING : 0;
+    size_t offset = stages.size();
+    for (uint64_t i = begin; i < head; i++)
+    {
+      ProfileSample &sample = _samples[i & (PROFILE_RING - 1)];
+      stages.push_back(sample.stage.load(std::memory_order_relaxed));
+      starts.push_back(sample.start.load(std::memory_order_relaxed));
+      durations.push_back(sample.duration.load(std::memory_order_relaxed));
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t after = _head.load(std::memory_order_relaxed);
+    uint64_t valid = after >= PROFILE_RING ? after - PROFILE_RING + 1 : 0; // 更早的记录可能已被覆盖
+    if (valid > begin)
+    {
+      size_t skip = std::min<uint64_t>(valid - begin, head - begin);
+      stages.erase(stages.begin() + offset, stages.begin() + offset + skip);
+      starts.erase(starts.begin() + offset, starts.begin() + offset + skip);
+      durations.erase(durations.begin() + offset, durations.begin() + offset + skip);
+    }
+  }
+
+  /**
+   * @brief 累加硬件计数器增量
+   *
+   */
+  void addCounters(int stage, const uint64_t delta[PERF_VALUES])
+  {
+    for (int i = 0; i < PERF_VALUES; i++)
+      _counters[stage][i].store(_counters[stage][i].load(std::memory_order_relaxed) + delta[i],
+                                std::memory_order_relaxed);
+    _counted[stage].store(_counted[stage].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  uint64_t count(int stage) { return _count[stage].load(std::memory_order_relaxed); }
+  uint64_t max(int stage) { return _max[stage].load(std::memory_order_relaxed); }
+  uint64_t counted(int stage) { return _counted[stage].load(std::memory_order_relaxed); }
+  uint64_t counter(int stage, int counter) { return _counters[stage][counter].load(std::memory_order_relaxed); }
+
+private:
+  ProfileSample _samples[PROFILE_RING];
+  std::atomic<uint64_t> _head{0}; // 已写入的记录数
+  std::atomic<uint64_t> _count[PROFILE_STAGES] = {};
+  std::atomic<uint64_t> _max[PROFILE_STAGES] = {};
+  std::atomic<uint64_t> _counted[PROFILE_STAGES] = {};                 // 带计数器的计时次数
+  std::atomic<uint64_t> _counters[PROFILE_STAGES][PERF_VALUES] = {};   // 计数器累计增量（含启用/计数时间）
+};
+
+/**
+ * @brief 单帧各阶段耗时统计：阶段按名称注册，计时写入各线程的环形缓冲，输出p50/p95/p99/max
+ *
+ * 每次计时两次读取单调时钟（vDSO）并写入线程私有缓冲，无锁无分配，比赛模式下可常开
+ */
+class Profiler
+{
+public:
+  static Profiler &instance()
+  {
+    static Profiler profiler;
+    return profiler;
+  }
+
+  /**
+   * @brief 注册计时阶段（同名返回已有序号）
+   *
+   */
+  int stage(const std::string &name)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (int i = 0; i < _stages.size(); i++)
+    {
+      if (_stages[i] == name)
+        return i;
+    }
+    if (_stages.size() >= PROFILE_STAGES)
+    {
+      std::cout << "Warning: profile stages exceed " << PROFILE_STAGES << ": " << name << std::endl;
+      return PROFILE_STAGES - 1;
+    }
+    _stages.push_back(name);
+    return _stages.size() - 1;
+  }
+
+  std::string stageName(int stage)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return stage < _stages.size() ? _stages[stage] : "?";
+  }
+
+  static bool enabled() { return _enabled.load(std::memory_order_relaxed); }
+  static void enable(bool enable) { _enabled.store(enable, std::memory_order_relaxed); }
+
+  /**
+   * @brief 硬件计数器模式：各阶段同时统计指令/周期/缓存与分支未命中（每次计时两次read()系统调用）
+   *
+   */
+  static bool countersEnabled() { return _countersEnabled.load(std::memory_order_relaxed); }
+  static void enableCounters(bool enable) { _countersEnabled.store(enable, std::memory_order_relaxed); }
+
+  /**
+   * @brief 读取本线程的计数器组（首次调用时打开）；不可用时关闭计数器模式，只统计时间
+   *
+   */
+  bool readCounters(uint64_t values[PERF_VALUES])
+  {
+    static thread_local PerfCounters counters;
+    static thread_local bool opened = false;
+    if (!opened)
+    {
+      opened = true;
+      if (!counters.open())
+      {
+        enableCounters(false);
+        if (!_countersWarned.exchange(true))
+          std::cout << "Warning: hardware counters unavailable (" << counters.error()
+                    << "), profiling time only" << std::endl;
+        return false;
+      }
+    }
+    return counters.read(values);
+  }
+
+  /**
+   * @brief 单调时钟（ns）
+   *
+   */
+  static uint64_t now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  /**
+   * @brief 写入本线程的环形缓冲
+   *
+   */
+  void record(int stage, uint64_t start, uint64_t duration)
+  {
+    ring().push(stage, start, duration);
+  }
+
+  void record(int stage, uint64_t start, uint64_t duration, const uint64_t delta[PERF_VALUES])
+  {
+    ProfileRing &current = ring();
+    current.push(stage, start, duration);
+    current.addCounters(stage, delta);
+  }
+
+  /**
+   * @brief 已注册的线程缓冲（线程退出后保留）
+   *
+   */
+  std::vector<ProfileRing *> rings()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _rings;
+  }
+
+  /**
+   * @brief 请求输出统计（可在信号处理函数中调用），由poll()在工作线程中输出
+   *
+   */
+  void requestReport() { _reportRequest.store(true, std::memory_order_relaxed); }
+
+  void poll()
+  {
+    if (_reportRequest.load(std::memory_order_relaxed) &&
+        _reportRequest.exchange(false, std::memory_order_relaxed))
+      report();
+  }
+
+  /**
+   * @brief 输出各阶段耗时：次数/最大值为累计，百分位为各线程缓冲中最近的记录
+   *
+   */
+  void report(std::ostream &out = std::cout)
+  {
+    std::vector<ProfileRing *> threads = rings();
+    std::vector<uint32_t> stages;
+    std::vector<uint64_t> starts, durations;
+    for (ProfileRing *ring : threads)
+      ring->snapshot(stages, starts, durations);
+
+    int count;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      count = _stages.size();
+    }
+    std::vector<std::vector<uint64_t>> samples(count);
+    for (int i = 0; i < stages.size(); i++)
+    {
+      if (stages[i] < count)
+        samples[stages[i]].push_back(durations[i]);
+    }
+
+    std::ios state(nullptr);
+    state.copyfmt(out);
+    out << "Profile [ms]   " << std::setw(10) << "count" << std::setw(9) << "p50"
+        << std::setw(9) << "p95" << std::setw(9) << "p99" << std::setw(9) << "max" << std::endl;
+    out << std::fixed << std::setprecision(3);
+    for (int i = 0; i < count; i++)
+    {
+      uint64_t total = 0, max = 0;
+      for (ProfileRing *ring : threads)
+      {
+        total += ring->count(i);
+        max = std::max(max, ring->max(i));
+      }
+      if (total == 0)
+        continue;
+      out << std::left << std::setw(15) << stageName(i) << std::right << std::setw(10) << total
+          << std::setw(9) << percentile(samples[i], 0.50) << std::setw(9)
+          << percentile(samples[i], 0.95) << std::setw(9) << percentile(samples[i], 0.99)
+          << std::setw(9) << max / 1e6 << std::endl;
+    }
+    reportCounters(out, threads, count);
+    out.copyfmt(state);
+  }
+
+  /**
+   * @brief 导出Chrome/Perfetto时间线（trace-event JSON，chrome://tracing或ui.perfetto.dev打开）
+   *
+   * 每个计时为一个完整事件（ph:X），按线程分行；内容为各线程缓冲中最近的PROFILE_RING条记录
+   */
+  bool writeTrace(const std::string &path)
+  {
+    std::ofstream out(path);
+    if (!out.is_open())
+    {
+      std::cout << "Error: open trace file failed: " << path << std::endl;
+      return false;
+    }
+    std::vector<ProfileRing *> threads = rings();
+    std::vector<std::vector<uint32_t>> stages(threads.size());
+    std::vector<std::vector<uint64_t>> starts(threads.size()), durations(threads.size());
+    uint64_t base = UINT64_MAX; // 时间线起点：最早的记录
+    for (int i = 0; i < threads.size(); i++)
+    {
+      threads[i]->snapshot(stages[i], starts[i], durations[i]);
+      if (!starts[i].empty())
+        base = std::min(base, starts[i][0]);
+    }
+
+    int count;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      count = _stages.size();
+    }
+    std::vector<std::string> names(count);
+    for (int i = 0; i < count; i++)
+      names[i] = jsonEscape(stageName(i)); // 阶段/线程名由调用方给出：可能含引号或反斜杠
+
+    int events = 0;
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::endl;
+    out << std::fixed << std::setprecision(3);
+    for (int i = 0; i < threads.size(); i++)
+    {
+      out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i + 1
+          << ",\"args\":{\"name\":\"" << jsonEscape(threads[i]->thread) << "\"}}";
+      for (int k = 0; k < stages[i].size(); k++, events++)
+      {
+        out << ",\n{\"name\":\"" << (stages[i][k] < count ? names[stages[i][k]] : "?")
+            << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << i + 1
+            << ",\"ts\":" << (starts[i][k] - base) / 1e3 << ",\"dur\":" << durations[i][k] / 1e3
+            << "}";
+      }
+      out << (i + 1 < threads.size() ? ",\n" : "\n");
+    }
+    out << "]}" << std::endl;
+    std::cout << "Trace: " << events << " events, " << threads.size() << " threads -> " << path
+              << std::endl;
+    return true;
+  }
+
+private:
+  static inline std::atomic<bool> _enabled{true};
+  static inline std::atomic<bool> _countersEnabled{false};
+  static inline std::atomic<bool> _countersWarned{false};
+  std::atomic<bool> _reportRequest{false};
+  std::mutex _mutex;
+  std::vector<std::string> _stages;
+  std::vector<ProfileRing *> _rings;
+
+  ProfileRing &ring()
+  {
+    static thread_local ProfileRing *ring = nullptr;
+    if (ring == nullptr)
+      ring = registerThread();
+    return *ring;
+  }
+
+  /**
+   * @brief 硬件计数器统计输出：单次平均指令/周期、IPC、缓存与分支未命中率
+   *
+   * @note run%为计数器组实际计数时间占比：低于100%时计数器被分时复用，读数按比例缩放并以*标记
+   */
+  void reportCounters(std::ostream &out, std::vector<ProfileRing *> &threads, int count)
+  {
+    bool header = false, multiplexed = false;
+    for (int i = 0; i < count; i++)
+    {
+      uint64_t counted = 0, totals[PERF_VALUES] = {};
+      for (ProfileRing *ring : threads)
+      {
+        counted += ring->counted(i);
+        for (int k = 0; k < PERF_VALUES; k++)
+          totals[k] += ring->counter(i, k);
+      }
+      if (counted == 0)
+        continue;
+      if (!header)
+      {
+        out << "Counters       " << std::setw(10) << "kinst" << std::setw(10) << "kcycle"
+            << std::setw(7) << "IPC" << std::setw(9) << "cache%" << std::setw(9) << "branch%"
+            << std::setw(7) << "MPKI" << std::setw(8) << "run%" << std::endl;
+        header = true;
+      }
+      double enabled = totals[PerfCounters::TimeEnabled];
+      double running = totals[PerfCounters::TimeRunning];
+      double scale = running > 0 && running < enabled ? enabled / running : 1.0; // 复用缩放
+      bool scaled = scale > 1.0;
+      multiplexed |= scaled;
+      double instructions = totals[PerfCounters::Instructions] * scale;
+      double cycles = totals[PerfCounters::Cycles] * scale;
+      double references = totals[PerfCounters::CacheReferences];
+      double branches = totals[PerfCounters::Branches];
+      out << std::left << std::setw(15) << stageName(i) << std::right << std::setprecision(1)
+          << std::setw(10) << instructions / counted / 1000 << std::setw(10) << cycles / counted / 1000
+          << std::setprecision(2) << std::setw(7) << (cycles > 0 ? instructions / cycles : 0)
+          << std::setprecision(1) << std::setw(9)
+          << (references > 0 ? 100 * totals[PerfCounters::CacheMisses] / references : 0)
+          << std::setw(9) << (branches > 0 ? 100 * totals[PerfCounters::BranchMisses] / branches : 0)
+          << std::setw(7)
+          << (instructions > 0 ? 1000 * totals[PerfCounters::CacheMisses] * scale / instructions : 0)
+          << std::setw(7) << (enabled > 0 ? 100 * running / enabled : 100) << (scaled ? "*" : " ")
+          << std::endl;
+    }
+    if (multiplexed)
+      out << "* counters multiplexed: counts scaled by time_enabled/time_running (estimates)"
+          << std::endl;
+  }
+
+  ProfileRing *registerThread()
+  {
+    ProfileRing *ring = new ProfileRing(); // 与进程同生命周期
+    char name[16] = {};
+    pthread_getname_np(pthread_self(), name, sizeof(name));
+    ring->thread = name;
+    std::lock_guard<std::mutex> lock(_mutex);
+    _rings.push_back(ring);
+    return ring;
+  }
+
+  /**
+   * @brief JSON字符串转义：引号、反斜杠与控制字符
+   *
+   */
+  static std::string jsonEscape(const std::string &text)
+  {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (unsigned char c : text)
+    {
+      if (c == '"' || c == '\\')
+      {
+        escaped += '\\';
+        escaped += c;
+      }
+      else if (c < 0x20)
+      {
+        char code[8];
+        snprintf(code, sizeof(code), "\\u%04x", c);
+        escaped += code;
+      }
+      else
+        escaped += c;
+    }
+    return escaped;
+  }
+
+  static double percentile(std::vector<uint64_t> &samples, double ratio)
+  {
+    if (samples.empty())
+      return 0;
+    size_t index = std::min<size_t>(samples.size() * ratio, samples.size() - 1);
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index] / 1e6;
+  }
+};
+
+/**
+ * @brief 作用域计时：构造时开始，析构时写入本线程缓冲
+ *
+ */
+class ProfileScope
+{
+public:
+  explicit ProfileScope(int stage) : _stage(stage)
+  {
+    if (!Profiler::enabled())
+      return;
+    _counting = Profiler::countersEnabled() && Profiler::instance().readCounters(_counters);
+    _start = Profiler::now();
+  }
+
+  ~ProfileScope()
+  {
+    if (_start == 0)
+      return;
+    uint64_t duration = Profiler::now() - _start;
+    uint64_t counters[PERF_VALUES];
+    if (_counting && Profiler::instance().readCounters(counters))
+    {
+      for (int i = 0; i < PERF_VALUES; i++)
+        counters[i] -= _counters[i];
+      Profiler::instance().record(_stage, _start, duration, counters);
+    }
+    else
+      Profiler::instance().record(_stage, _start, duration);
+  }
+
+private:
+  int _stage;
+  uint64_t _start = 0;
+  bool _counting = false;
+  uint64_t _counters[PERF_VALUES]; // 开始时的计数器读数
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+// 当前作用域计时：阶段首次执行时注册
+#define PROFILE_SCOPE(name)                                                                     \
+  static const int PROFILE_CONCAT(_profileStage, __LINE__) = Profiler::instance().stage(name); \
+  ProfileScope PROFILE_CONCAT(_profileScope, __LINE__)(PROFILE_CONCAT(_profileStage, __LINE__))
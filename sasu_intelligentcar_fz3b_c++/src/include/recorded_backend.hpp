@@ -0,0 +1,83 @@
+#pragma once
+
+#include "inference_backend.hpp"
+#include <fstream>
+#include <map>
+#include <sstream>
+
+/**
+ * @brief 录制结果回放后端：按图像帧序号返回录制的检测结果，不运行模型
+ *
+ * @note 文件每行一个目标："帧序号 type label score x y width height"，帧序号为录制中的位置（从0开始），
+ *       即采集帧序号frame_id - 1；推理慢于采集时跳过的帧不影响后续帧的对应关系
+ */
+class RecordedBackend : public InferenceBackend
+{
+private:
+  std::map<int, std::vector<PredictResult>> _records;
+
+public:
+  int init(std::shared_ptr<ModelConfig> &config) override
+  {
+    if (!load(config->record_file, _records))
+    {
+      std::cout << "Error: Recorded detections not found: "
+                << config->record_file << std::endl;
+      return -1;
+    }
+    return 0;
+  }
+
+  void run(cv::Mat &inputFrame, std::vector<PredictResult> &results, uint64_t frameId) override
+  {
+    auto it = _records.find((int)frameId - 1);
+    if (it == _records.end())
+      results.clear();
+    else
+      results = it->second;
+  }
+
+  std::string name() override { return "recorded"; }
+
+  /**
+   * @brief 读取录制的检测结果
+   *
+   * @param path 文件路径
+   * @param records 输出：帧序号 -> 检测结果
+   * @return true 文件可读
+   */
+  static bool load(std::string path, std::map<int, std::vector<PredictResult>> &records)
+  {
+    std::ifstream file(path);
+    if (!file.good())
+      return false;
+    std::string line;
+    while (getline(file, line))
+    {
+      std::istringstream stream(line);
+      int frame;
+      PredictResult result;
+      if (stream >> frame >> result.type >> result.label >> result.score >>
+          result.x >> result.y >> result.width >> result.height)
+        records[frame].push_back(result);
+    }
+    return true;
+  }
+
+  /**
+   * @brief 追加一帧检测结果（录制）
+   *
+   */
+  static void save(std::ostream &file, int frame, std::vector<PredictResult> &results)
+  {
+    for (int i = 0; i < results.size(); i++)
+    {
+      std::string label = results[i].label; // 标签仅供阅读，回放按type分组
+      if (label.empty())
+        label = results[i].type >= 0 && results[i].type < LABEL_COUNT ? LABEL_NAMES[results[i].type] : "-";
+      file << frame << " " << results[i].type << " " << label << " "
+           << results[i].score << " " << results[i].x << " " << results[i].y
+           << " " << results[i].width << " " << results[i].height << "\n";
+    }
+  }
+};
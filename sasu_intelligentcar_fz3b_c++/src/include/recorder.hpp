@@ -0,0 +1,230 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 异步存图：调用线程只拷贝图像到预分配槽位，JPEG编码与写文件在后台线程执行
+ *
+ * 槽位为有界无锁环形队列（多生产者/单消费者，按序号领取槽位），槽位图像缓存复用不重复分配；
+ * 队满时按策略丢弃当前帧或等待空位。文件按提交序号命名，丢弃的帧在序号中留空
+ * 写线程在首次存图时才启动（不存图时没有后台线程），队空时阻塞在条件变量上，由提交唤醒
+ */
+class Recorder
+{
+public:
+  /**
+   * @brief 全局存图实例（savePicture使用）
+   *
+   */
+  static Recorder &instance()
+  {
+    static Recorder recorder;
+    return recorder;
+  }
+
+  ~Recorder() { stop(); }
+
+  /**
+   * @brief 设置队列参数（首次存图前调用，未调用时按默认参数）：写线程在首次存图时启动
+   *
+   * @param slots 槽位数（向上取2的幂）
+   * @param block 队满时等待空位（false：丢弃当前帧）
+   * @param path 存图目录
+   */
+  void init(int slots, bool block, const std::string &path = "../res/samples/train/")
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    stopWriter();
+    _slots = slots;
+    _block = block;
+    _path = path;
+  }
+
+  /**
+   * @brief 提交一帧（拷贝到槽位后立即返回）
+   *
+   * @return false 队满丢弃
+   */
+  bool push(const cv::Mat &image)
+  {
+    if (!_ready.load(std::memory_order_acquire))
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (!_ready.load(std::memory_order_acquire))
+        start();
+    }
+
+    uint64_t index = _submitted.fetch_add(1, std::memory_order_relaxed) + 1; // 文件序号
+    uint64_t position = _enqueue.load(std::memory_order_relaxed);
+    int spins = 0;
+    Cell *cell;
+    while (true)
+    {
+      cell = &_cells[position & _mask];
+      int64_t diff = (int64_t)cell->sequence.load(std::memory_order_acquire) - (int64_t)position;
+      if (diff == 0)
+      {
+        if (_enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (diff < 0) // 队满
+      {
+        if (!_block)
+        {
+          _dropped.fetch_add(1, std::memory_order_relaxed);
+          return false;
+        }
+        wait(spins);
+        position = _enqueue.load(std::memory_order_relaxed);
+      }
+      else
+        position = _enqueue.load(std::memory_order_relaxed);
+    }
+
+    image.copyTo(cell->image); // 尺寸/类型不变时复用槽位缓存
+    cell->index = index;
+    cell->sequence.store(position + 1, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst); // 与写线程：先置等待标志再复查队列
+    if (_waiting.load(std::memory_order_relaxed))
+    {
+      std::lock_guard<std::mutex> lock(_wakeMutex);
+      _wake.notify_one();
+    }
+    return true;
+  }
+
+  /**
+   * @brief 写完队列中剩余的图像后停止写线程
+   *
+   */
+  void stop()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    stopWriter();
+  }
+
+  uint64_t submitted() { return _submitted.load(std::memory_order_relaxed); } // 提交帧数
+  uint64_t written() { return _written.load(std::memory_order_relaxed); }     // 已写入帧数
+  uint64_t dropped() { return _dropped.load(std::memory_order_relaxed); }     // 队满丢弃帧数
+
+  /**
+   * @brief 存图统计输出
+   *
+   */
+  void printStatistics()
+  {
+    uint64_t written = _written.load(std::memory_order_relaxed);
+    std::cout << "Recorder submitted: " << submitted() << " written: " << written
+              << " dropped: " << dropped() << " encode mean: "
+              << (written ? _encodeTotal.load(std::memory_order_relaxed) / written : 0) / 1000.0
+              << "ms" << std::endl;
+  }
+
+private:
+  struct Cell
+  {
+    std::atomic<uint64_t> sequence{0}; // 槽位状态：等于领取序号-空闲，等于序号+1-已写入待编码
+    uint64_t index = 0;
+    cv::Mat image;
+  };
+
+  std::vector<Cell> _cells;
+  uint64_t _mask = 0;
+  std::atomic<uint64_t> _enqueue{0}; // 生产者：下一个领取序号
+  uint64_t _dequeue = 0;             // 写线程：下一个读取序号
+  int _slots = 8;
+  bool _block = false;
+  std::string _path = "../res/samples/train/";
+  std::thread _writer;
+  std::atomic<bool> _stop{false};
+  std::atomic<bool> _ready{false};
+  std::mutex _mutex; // 启动/停止
+
+  std::mutex _wakeMutex;             // 写线程队空等待
+  std::condition_variable _wake;
+  std::atomic<bool> _waiting{false}; // 写线程正在（或即将）等待：提交时需唤醒
+
+  std::atomic<uint64_t> _submitted{0};
+  std::atomic<uint64_t> _written{0};
+  std::atomic<uint64_t> _dropped{0};
+  std::atomic<uint64_t> _encodeTotal{0}; // 编码写文件总耗时（us）
+
+  void start()
+  {
+    stopWriter();
+    int capacity = 1;
+    while (capacity < _slots)
+      capacity <<= 1;
+    _cells = std::vector<Cell>(capacity);
+    for (int i = 0; i < capacity; i++)
+      _cells[i].sequence.store(i, std::memory_order_relaxed);
+    _mask = capacity - 1;
+    _enqueue.store(0, std::memory_order_relaxed);
+    _dequeue = 0;
+    _stop = false;
+    _writer = std::thread([this] { writerLoop(); });
+    _ready.store(true, std::memory_order_release);
+  }
+
+  void writerLoop()
+  {
+    while (true)
+    {
+      Cell &cell = _cells[_dequeue & _mask];
+      if (cell.sequence.load(std::memory_order_acquire) != _dequeue + 1) // 队空
+      {
+        if (_stop.load(std::memory_order_acquire) &&
+            _enqueue.load(std::memory_order_acquire) == _dequeue)
+          return;
+        std::unique_lock<std::mutex> lock(_wakeMutex);
+        _waiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst); // 与提交：先置等待标志再复查队列
+        if (cell.sequence.load(std::memory_order_relaxed) != _dequeue + 1 &&
+            !_stop.load(std::memory_order_relaxed))
+          _wake.wait(lock);
+        _waiting.store(false, std::memory_order_relaxed);
+        continue;
+      }
+
+      auto start = std::chrono::steady_clock::now();
+      cv::imwrite(_path + std::to_string(cell.index) + ".jpg", cell.image);
+      _encodeTotal.fetch_add(std::chrono::duration_cast<std::chrono::microseconds>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count(),
+                             std::memory_order_relaxed);
+      _written.fetch_add(1, std::memory_order_relaxed);
+
+      cell.sequence.store(_dequeue + _mask + 1, std::memory_order_release); // 归还槽位
+      _dequeue++;
+    }
+  }
+
+  void stopWriter()
+  {
+    _ready.store(false, std::memory_order_release);
+    {
+      std::lock_guard<std::mutex> lock(_wakeMutex);
+      _stop = true;
+      _wake.notify_one();
+    }
+    if (_writer.joinable())
+      _writer.join();
+  }
+
+  static void wait(int &spins) // 生产者等待空位（仅block模式队满时）
+  {
+    if (++spins < 64) // 先让出CPU，再短暂休眠
+      std::this_thread::yield();
+    else
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+  }
+};
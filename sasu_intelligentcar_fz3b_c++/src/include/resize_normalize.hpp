@@ -0,0 +1,224 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <opencv2/opencv.hpp>
+#include <vector>
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief AI模型输入融合内核：双线性缩放 + BGR/RGB通道交换 + (x-mean)*scale + NHWC/NCHW打包，一次遍历完成
+ *
+ * 与cv::resize(INTER_LINEAR)的像素中心对齐方式一致：
+ * 水平方向按查找表（源偏移/权重/归一化系数，已包含通道交换及输出布局）逐元素插值并归一化，
+ * 每个源行只计算一次并缓存；垂直方向对两行缓存做SIMD线性插值后直接写入输出张量
+ * @note 归一化为线性运算，先归一化后插值与先插值后归一化结果相同（浮点误差内）；
+ *       cv::resize输出取整为8位，与之相比误差不超过1个灰度级 * scale
+ */
+class ResizeNormalize
+{
+public:
+  enum Layout
+  {
+    NHWC = 0,
+    NCHW
+  };
+
+  /**
+   * @brief 参数设置（输出尺寸/归一化/通道顺序/布局），输入尺寸在首帧时确定
+   *
+   * @param width 输出宽度
+   * @param height 输出高度
+   * @param means 均值（输出通道顺序）
+   * @param scales 缩放系数（输出通道顺序）
+   * @param swapRB true：输出RGB；false：输出BGR
+   * @param layout 输出布局
+   */
+  void init(int width, int height, const float means[3], const float scales[3],
+            bool swapRB, Layout layout)
+  {
+    _ow = width;
+    _oh = height;
+    for (int c = 0; c < 3; c++)
+    {
+      _means[c] = means[c];
+      _scales[c] = scales[c];
+    }
+    _swapRB = swapRB;
+    _layout = layout;
+    _iw = _ih = 0; // 首帧重建查找表
+  }
+
+  /**
+   * @brief 单帧处理
+   *
+   * @param bgr 输入BGR图像（CV_8UC3，可为非连续ROI）
+   * @param dst 输出张量：1x3xHxW（NCHW）或1xHxWx3（NHWC）
+   */
+  void run(const cv::Mat &bgr, float *dst)
+  {
+    if (bgr.cols != _iw || bgr.rows != _ih)
+      build(bgr.cols, bgr.rows);
+
+    const int n = _ow * 3;
+    int rowCached[2] = {-1, -1}; // 两行缓存对应的源行
+    for (int y = 0; y < _oh; y++)
+    {
+      int sy0 = _yofs[y * 2], sy1 = _yofs[y * 2 + 1];
+      // 源行缓存：逐行下移时复用上一输出行已计算的源行
+      if (rowCached[0] != sy0)
+      {
+        if (rowCached[1] == sy0)
+        {
+          std::swap(_rows[0], _rows[1]);
+          std::swap(rowCached[0], rowCached[1]);
+        }
+        else
+        {
+          horizontal(bgr.ptr<uint8_t>(sy0), _rows[0].data());
+          rowCached[0] = sy0;
+        }
+      }
+      if (rowCached[1] != sy1)
+      {
+        horizontal(bgr.ptr<uint8_t>(sy1), _rows[1].data());
+        rowCached[1] = sy1;
+      }
+
+      float beta = _beta[y];
+      if (_layout == NHWC)
+        vertical(_rows[0].data(), _rows[1].data(), beta, dst + (size_t)y * n, n);
+      else
+      {
+        for (int c = 0; c < 3; c++)
+          vertical(_rows[0].data() + c * _ow, _rows[1].data() + c * _ow, beta,
+                   dst + ((size_t)c * _oh + y) * _ow, _ow);
+      }
+    }
+  }
+
+private:
+  int _iw = 0, _ih = 0; // 输入尺寸
+  int _ow = 0, _oh = 0; // 输出尺寸
+  float _means[3] = {0, 0, 0};
+  float _scales[3] = {1, 1, 1};
+  bool _swapRB = false;
+  Layout _layout = NHWC;
+
+  // 水平查找表：按缓存行元素顺序（已包含通道交换与布局）
+  std::vector<int> _xofs0, _xofs1; // 左右源像素的字节偏移
+  std::vector<float> _alpha;       // 右侧权重
+  std::vector<float> _scale;       // 归一化：v * scale - mean * scale
+  std::vector<float> _bias;
+  // 垂直查找表
+  std::vector<int> _yofs; // 上下源行
+  std::vector<float> _beta;
+  std::vector<float> _rows[2]; // 已插值、归一化的源行缓存
+
+  /**
+   * @brief 源坐标计算：与cv::resize(INTER_LINEAR)一致（像素中心对齐，边界钳位）
+   *
+   */
+  static void mapCoord(int dst, double scale, int size, int &s0, int &s1, float &weight)
+  {
+    float f = (float)((dst + 0.5) * scale - 0.5);
+    int s = (int)std::floor(f);
+    f -= s;
+    if (s < 0)
+    {
+      s = 0;
+      f = 0;
+    }
+    if (s >= size - 1)
+    {
+      s = size - 1;
+      f = 0;
+    }
+    s0 = s;
+    s1 = std::min(s + 1, size - 1);
+    weight = f;
+  }
+
+  void build(int iw, int ih)
+  {
+    _iw = iw;
+    _ih = ih;
+    const int n = _ow * 3;
+    _xofs0.resize(n);
+    _xofs1.resize(n);
+    _alpha.resize(n);
+    _scale.resize(n);
+    _bias.resize(n);
+    for (int x = 0; x < _ow; x++)
+    {
+      int sx0, sx1;
+      float alpha;
+      mapCoord(x, (double)iw / _ow, iw, sx0, sx1, alpha);
+      for (int c = 0; c < 3; c++) // c：输出通道
+      {
+        int j = _layout == NHWC ? x * 3 + c : c * _ow + x;
+        int channel = _swapRB ? 2 - c : c; // 源（BGR）通道
+        _xofs0[j] = sx0 * 3 + channel;
+        _xofs1[j] = sx1 * 3 + channel;
+        _alpha[j] = alpha;
+        _scale[j] = _scales[c];
+        _bias[j] = -_means[c] * _scales[c];
+      }
+    }
+
+    _yofs.resize(_oh * 2);
+    _beta.resize(_oh);
+    for (int y = 0; y < _oh; y++)
+      mapCoord(y, (double)ih / _oh, ih, _yofs[y * 2], _yofs[y * 2 + 1], _beta[y]);
+
+    _rows[0].resize(n);
+    _rows[1].resize(n);
+  }
+
+  /**
+   * @brief 水平插值 + 通道交换 + 归一化 + 布局重排（查找表驱动）
+   *
+   */
+  void horizontal(const uint8_t *src, float *row)
+  {
+    const int n = _ow * 3;
+    const int *xofs0 = _xofs0.data(), *xofs1 = _xofs1.data();
+    const float *alpha = _alpha.data(), *scale = _scale.data(), *bias = _bias.data();
+    for (int j = 0; j < n; j++)
+    {
+      float v0 = src[xofs0[j]], v1 = src[xofs1[j]];
+      row[j] = (v0 + alpha[j] * (v1 - v0)) * scale[j] + bias[j];
+    }
+  }
+
+  /**
+   * @brief 垂直插值：dst = r0 + beta * (r1 - r0)
+   *
+   */
+  static void vertical(const float *r0, const float *r1, float beta, float *dst, int n)
+  {
+    int j = 0;
+#if defined(__aarch64__)
+    float32x4_t b = vdupq_n_f32(beta);
+    for (; j + 4 <= n; j += 4)
+    {
+      float32x4_t a0 = vld1q_f32(r0 + j);
+      vst1q_f32(dst + j, vfmaq_f32(a0, b, vsubq_f32(vld1q_f32(r1 + j), a0)));
+    }
+#elif defined(__SSE2__)
+    __m128 b = _mm_set1_ps(beta);
+    for (; j + 4 <= n; j += 4)
+    {
+      __m128 a0 = _mm_loadu_ps(r0 + j);
+      _mm_storeu_ps(dst + j, _mm_add_ps(a0, _mm_mul_ps(b, _mm_sub_ps(_mm_loadu_ps(r1 + j), a0))));
+    }
+#endif
+    for (; j < n; j++)
+      dst[j] = r0[j] + beta * (r1[j] - r0[j]);
+  }
+};
@@ -0,0 +1,552 @@
+#pragma once
+
+#include "common.hpp"
+#include "predict_result.hpp"
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * @brief 运行日志单帧数据：原始图像、AI检测结果、赛道边缘与控制输出
+ *
+ */
+struct RunLogFrame
+{
+  uint32_t frameId = 0;             // 图像帧序号
+  double time = 0;                  // 帧时间（ms）：驱动计时器的时间
+  cv::Mat image;                    // 原始图像（BGR/YUYV/灰度）：读取原始存储时指向映射内存
+  std::vector<PredictResult> predicts; // AI检测结果（元素识别前）
+  bool predictsFresh = true;        // 新的推理结果（false：沿用上次推理的结果）
+  std::vector<POINT> edgeLeft;      // 赛道左边缘
+  std::vector<POINT> edgeRight;     // 赛道右边缘
+  int roadType = 0;                 // 赛道类型
+  int controlCenter = 0;            // 控制中心
+  uint16_t servoPwm = 0;            // 舵机PWM
+  float motorSpeed = 0;             // 规划车速
+  float controlSpeed = 0;           // 下发速度（0：未下发）
+};
+
+/**
+ * @brief 运行日志文件格式：文件头 + 逐帧追加的变长记录（小端，8字节对齐）
+ *
+ * 记录 = RunLogRecord + RunLogPredict[predictCount] + RunLogPoint[edgeLeftCount + edgeRightCount] + 图像数据
+ */
+struct RunLogHeader
+{
+  char magic[8];     // "ICARLOG1"
+  uint32_t version;  // 格式版本
+  uint32_t reserved;
+  double timeStart;  // 比赛开始时间（ms，-1：未开始）
+};
+
+struct RunLogRecord
+{
+  uint32_t magic;    // RUNLOG_RECORD_MAGIC
+  uint32_t size;     // 记录总字节数（含本结构）
+  uint32_t frameId;
+  uint32_t flags;    // RUNLOG_JPEG：图像为JPEG编码；RUNLOG_STALE：AI结果沿用上次推理
+  double time;
+  int32_t roadType;
+  int32_t controlCenter;
+  float motorSpeed;
+  float controlSpeed;
+  uint16_t servoPwm;
+  uint16_t reserved;
+  int32_t imageType; // OpenCV图像类型（CV_8UC3/CV_8UC2/CV_8UC1）
+  uint16_t imageCols;
+  uint16_t imageRows;
+  uint32_t imageBytes;
+  uint32_t predictCount;
+  uint16_t edgeLeftCount;
+  uint16_t edgeRightCount;
+};
+
+struct RunLogPredict
+{
+  int32_t type;
+  float score;
+  int16_t x, y, width, height;
+};
+
+struct RunLogPoint
+{
+  int16_t x, y;
+};
+
+static_assert(sizeof(RunLogHeader) == 24, "RunLogHeader layout");
+static_assert(sizeof(RunLogRecord) == 64, "RunLogRecord layout");
+static_assert(sizeof(RunLogPredict) == 16, "RunLogPredict layout");
+
+#define RUNLOG_VERSION 1
+#define RUNLOG_RECORD_MAGIC 0x4D415246 // "FRAM"
+#define RUNLOG_JPEG 0x1
+#define RUNLOG_STALE 0x2
+
+/**
+ * @brief 运行日志写入：单文件顺序追加，带缓冲的整条记录写入
+ *
+ * 替代逐帧imwrite的编号图片：无逐文件创建开销，写入速度只受存储带宽限制
+ */
+class RunLogWriter
+{
+public:
+  ~RunLogWriter() { close(); }
+
+  /**
+   * @brief 新建日志文件
+   *
+   * @param path 文件路径
+   * @param timeStart 比赛开始时间（ms）
+   * @param jpeg 图像JPEG编码存储（false：原始数据，写入最快；YUYV图像始终原始存储）
+   */
+  bool open(const std::string &path, double timeStart, bool jpeg = false)
+  {
+    close();
+    _file = fopen(path.c_str(), "wb");
+    if (_file == nullptr)
+      return false;
+    setvbuf(_file, nullptr, _IOFBF, 4 << 20);
+    RunLogHeader header = {};
+    memcpy(header.magic, "ICARLOG1", 8);
+    header.version = RUNLOG_VERSION;
+    header.timeStart = timeStart;
+    if (fwrite(&header, sizeof(header), 1, _file) != 1)
+    {
+      close();
+      return false;
+    }
+    _jpeg = jpeg;
+    _frames = 0;
+    _bytes = sizeof(header);
+    return true;
+  }
+
+  bool isOpen() { return _file != nullptr; }
+
+  /**
+   * @brief 追加一帧
+   *
+   * @note 写入失败（如存储已满）时输出错误并关闭日志，后续帧不再记录
+   */
+  void write(const RunLogFrame &frame)
+  {
+    if (_file == nullptr)
+      return;
+
+    const uchar *image = frame.image.data;
+    size_t imageBytes = frame.image.total() * frame.image.elemSize();
+    bool jpeg = _jpeg && !frame.image.empty() && frame.image.channels() != 2;
+    if (jpeg)
+    {
+      cv::imencode(".jpg", frame.image, _encoded);
+      image = _encoded.data();
+      imageBytes = _encoded.size();
+    }
+
+    size_t size = sizeof(RunLogRecord) + frame.predicts.size() * sizeof(RunLogPredict) +
+                  (frame.edgeLeft.size() + frame.edgeRight.size()) * sizeof(RunLogPoint) +
+                  imageBytes;
+    size = (size + 7) & ~size_t(7);
+    _buffer.resize(size);
+    uchar *data = _buffer.data();
+    memset(data, 0, sizeof(RunLogRecord));
+
+    RunLogRecord &record = *(RunLogRecord *)data;
+    record.magic = RUNLOG_RECORD_MAGIC;
+    record.size = size;
+    record.frameId = frame.frameId;
+    record.flags = (jpeg ? RUNLOG_JPEG : 0) | (frame.predictsFresh ? 0 : RUNLOG_STALE);
+    record.time = frame.time;
+    record.roadType = frame.roadType;
+    record.controlCenter = frame.controlCenter;
+    record.motorSpeed = frame.motorSpeed;
+    record.controlSpeed = frame.controlSpeed;
+    record.servoPwm = frame.servoPwm;
+    record.imageType = frame.image.type();
+    record.imageCols = frame.image.cols;
+    record.imageRows = frame.image.rows;
+    record.imageBytes = imageBytes;
+    record.predictCount = frame.predicts.size();
+    record.edgeLeftCount = frame.edgeLeft.size();
+    record.edgeRightCount = frame.edgeRight.size();
+    data += sizeof(RunLogRecord);
+
+    for (const PredictResult &result : frame.predicts)
+    {
+      RunLogPredict &predict = *(RunLogPredict *)data;
+      predict = {result.type, result.score, (int16_t)result.x, (int16_t)result.y,
+                 (int16_t)result.width, (int16_t)result.height};
+      data += sizeof(RunLogPredict);
+    }
+    for (const std::vector<POINT> *edge : {&frame.edgeLeft, &frame.edgeRight})
+    {
+      for (const POINT &point : *edge)
+      {
+        *(RunLogPoint *)data = {(int16_t)point.x, (int16_t)point.y};
+        data += sizeof(RunLogPoint);
+      }
+    }
+
+    if (jpeg || frame.image.isContinuous())
+      memcpy(data, image, imageBytes);
+    else
+    {
+      size_t rowBytes = frame.image.cols * frame.image.elemSize();
+      for (int i = 0; i < frame.image.rows; i++)
+        memcpy(data + i * rowBytes, frame.image.ptr(i), rowBytes);
+    }
+    data += imageBytes;
+    memset(data, 0, _buffer.data() + size - data);
+
+    if (fwrite(_buffer.data(), size, 1, _file) != 1)
+    {
+      std::cout << "Error: run log write failed: " << strerror(errno) << std::endl;
+      close();
+      return;
+    }
+    _frames++;
+    _bytes += size;
+  }
+
+  void close()
+  {
+    if (_file != nullptr)
+      fclose(_file);
+    _file = nullptr;
+  }
+
+  uint64_t frames() { return _frames; } // 已写入帧数
+  uint64_t bytes() { return _bytes; }   // 文件字节数
+
+private:
+  FILE *_file = nullptr;
+  bool _jpeg = false;
+  std::vector<uchar> _buffer;  // 单条记录（跨帧复用）
+  std::vector<uchar> _encoded; // JPEG编码结果（跨帧复用）
+  uint64_t _frames = 0;
+  uint64_t _bytes = 0;
+};
+
+/**
+ * @brief 运行日志后台写入：控制线程只把单帧拷入预分配槽位，JPEG编码与fwrite在后台线程执行
+ *
+ * 槽位环形队列与Recorder相同（按序号领取槽位，槽位图像/检测结果/边缘缓存复用），
+ * 单生产者（控制线程）/单消费者（写线程）；队满时丢弃当前帧，不阻塞控制。写线程队空时阻塞在条件变量上
+ */
+class RunLogQueue
+{
+public:
+  ~RunLogQueue() { close(); }
+
+  /**
+   * @brief 新建日志文件并启动写线程
+   *
+   * @param slots 槽位数（向上取2的幂）
+   */
+  bool open(const std::string &path, double timeStart, bool jpeg = false, int slots = 8)
+  {
+    close();
+    if (!_writer.open(path, timeStart, jpeg))
+      return false;
+    int capacity = 1;
+    while (capacity < slots)
+      capacity <<= 1;
+    _cells = std::vector<Cell>(capacity);
+    for (int i = 0; i < capacity; i++)
+      _cells[i].sequence.store(i, std::memory_order_relaxed);
+    _mask = capacity - 1;
+    _enqueue = 0;
+    _dropped = 0;
+    _stop = false;
+    _thread = std::thread([this] { writerLoop(); });
+    return true;
+  }
+
+  bool isOpen() { return _thread.joinable(); }
+
+  /**
+   * @brief 领取空闲槽位（控制线程）：填写后调用commit提交
+   *
+   * @return 槽位（队满返回nullptr：丢弃本帧）
+   */
+  RunLogFrame *acquire()
+  {
+    Cell &cell = _cells[_enqueue & _mask];
+    if (cell.sequence.load(std::memory_order_acquire) != _enqueue)
+    {
+      _dropped++;
+      return nullptr;
+    }
+    return &cell.frame;
+  }
+
+  /**
+   * @brief 提交acquire领取的槽位，唤醒写线程
+   *
+   */
+  void commit()
+  {
+    _cells[_enqueue & _mask].sequence.store(_enqueue + 1, std::memory_order_release);
+    _enqueue++;
+    std::atomic_thread_fence(std::memory_order_seq_cst); // 与写线程：先置等待标志再复查队列
+    if (_waiting.load(std::memory_order_relaxed))
+    {
+      std::lock_guard<std::mutex> lock(_wakeMutex);
+      _wake.notify_one();
+    }
+  }
+
+  /**
+   * @brief 写完队列中剩余的帧并关闭文件
+   *
+   */
+  void close()
+  {
+    if (_thread.joinable())
+    {
+      {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _stop = true;
+        _wake.notify_one();
+      }
+      _thread.join();
+    }
+    _writer.close();
+  }
+
+  uint64_t frames() { return _writer.frames(); } // 已写入帧数（close后读取）
+  uint64_t bytes() { return _writer.bytes(); }   // 文件字节数（close后读取）
+  uint64_t dropped() { return _dropped; }        // 队满丢弃帧数
+
+private:
+  struct Cell
+  {
+    std::atomic<uint64_t> sequence{0}; // 槽位状态：等于领取序号-空闲，等于序号+1-已填写待写入
+    RunLogFrame frame;
+  };
+
+  RunLogWriter _writer; // 仅写线程访问（open/close时写线程未运行）
+  std::vector<Cell> _cells;
+  uint64_t _mask = 0;
+  uint64_t _enqueue = 0; // 控制线程：下一个领取序号（写线程的读取序号在writerLoop内）
+  uint64_t _dropped = 0;
+  std::thread _thread;
+  std::atomic<bool> _stop{false};
+
+  std::mutex _wakeMutex;             // 写线程队空等待
+  std::condition_variable _wake;
+  std::atomic<bool> _waiting{false}; // 写线程正在（或即将）等待：提交时需唤醒
+
+  void writerLoop()
+  {
+    uint64_t dequeue = 0;
+    while (true)
+    {
+      Cell &cell = _cells[dequeue & _mask];
+      if (cell.sequence.load(std::memory_order_acquire) != dequeue + 1) // 队空
+      {
+        if (_stop.load(std::memory_order_acquire)) // 提交先于置位：复查仍队空即已写完
+        {
+          if (cell.sequence.load(std::memory_order_acquire) != dequeue + 1)
+            return;
+          continue;
+        }
+        std::unique_lock<std::mutex> lock(_wakeMutex);
+        _waiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst); // 与提交：先置等待标志再复查队列
+        if (cell.sequence.load(std::memory_order_relaxed) != dequeue + 1 &&
+            !_stop.load(std::memory_order_relaxed))
+          _wake.wait(lock);
+        _waiting.store(false, std::memory_order_relaxed);
+        continue;
+      }
+
+      _writer.write(cell.frame);
+      cell.sequence.store(dequeue + _mask + 1, std::memory_order_release); // 归还槽位
+      dequeue++;
+    }
+  }
+};
+
+/**
+ * @brief 运行日志读取：整个文件内存映射，打开时建立记录索引，按帧号随机访问
+ *
+ * 原始存储的图像直接指向映射内存（写时复制，修改不影响文件）；末尾不完整的记录（写入中断）被忽略
+ */
+class RunLogReader
+{
+public:
+  ~RunLogReader() { close(); }
+
+  bool open(const std::string &path)
+  {
+    close();
+    _fd = ::open(path.c_str(), O_RDONLY);
+    if (_fd < 0)
+      return false;
+    struct stat status;
+    if (fstat(_fd, &status) != 0 || status.st_size < sizeof(RunLogHeader))
+    {
+      close();
+      return false;
+    }
+    _length = status.st_size;
+    void *data = mmap(nullptr, _length, PROT_READ | PROT_WRITE, MAP_PRIVATE, _fd, 0);
+    if (data == MAP_FAILED)
+    {
+      close();
+      return false;
+    }
+    _data = (uchar *)data;
+    memcpy(&_header, _data, sizeof(_header));
+    if (memcmp(_header.magic, "ICARLOG1", 8) != 0 || _header.version != RUNLOG_VERSION)
+    {
+      std::cout << "Error: not a run log: " << path << std::endl;
+      close();
+      return false;
+    }
+
+    size_t offset = sizeof(RunLogHeader);
+    while (offset + sizeof(RunLogRecord) <= _length)
+    {
+      const RunLogRecord *record = (const RunLogRecord *)(_data + offset);
+      if (record->magic != RUNLOG_RECORD_MAGIC || record->size < sizeof(RunLogRecord) ||
+          offset + record->size > _length)
+        break;
+      if (!recordValid(*record))
+      {
+        std::cout << "Error: corrupted run log record [" << _offsets.size() << "]: " << path << std::endl;
+        break;
+      }
+      _offsets.push_back(offset);
+      offset += record->size;
+    }
+    return true;
+  }
+
+  /**
+   * @brief 判断文件是否为运行日志
+   *
+   */
+  static bool isRunLog(const std::string &path)
+  {
+    char magic[8] = {};
+    FILE *file = fopen(path.c_str(), "rb");
+    if (file == nullptr)
+      return false;
+    bool valid = fread(magic, 8, 1, file) == 1 && memcmp(magic, "ICARLOG1", 8) == 0;
+    fclose(file);
+    return valid;
+  }
+
+  /**
+   * @brief 记录内容校验：各段数据不超出记录长度，原始存储的图像尺寸与字节数一致
+   *
+   */
+  static bool recordValid(const RunLogRecord &record)
+  {
+    uint64_t payload = sizeof(RunLogRecord) + (uint64_t)record.predictCount * sizeof(RunLogPredict) +
+                       ((uint64_t)record.edgeLeftCount + record.edgeRightCount) * sizeof(RunLogPoint) +
+                       record.imageBytes;
+    if (payload > record.size)
+      return false;
+    if (record.imageBytes == 0 || (record.flags & RUNLOG_JPEG))
+      return true;
+    int type = record.imageType;
+    if (type != CV_MAT_TYPE(type) || CV_MAT_DEPTH(type) != CV_8U)
+      return false;
+    return (uint64_t)record.imageRows * record.imageCols * CV_ELEM_SIZE(type) == record.imageBytes;
+  }
+
+  int size() { return _offsets.size(); }     // 完整记录数
+  double timeStart() { return _header.timeStart; }
+
+  /**
+   * @brief 读取第index条记录
+   *
+   * @param frame 输出：原始存储的图像在下一次open()/close()前有效
+   */
+  bool read(int index, RunLogFrame &frame)
+  {
+    if (index < 0 || index >= _offsets.size())
+      return false;
+    uchar *data = _data + _offsets[index];
+    const RunLogRecord &record = *(const RunLogRecord *)data;
+    data += sizeof(RunLogRecord);
+
+    frame.frameId = record.frameId;
+    frame.time = record.time;
+    frame.predictsFresh = !(record.flags & RUNLOG_STALE);
+    frame.roadType = record.roadType;
+    frame.controlCenter = record.controlCenter;
+    frame.servoPwm = record.servoPwm;
+    frame.motorSpeed = record.motorSpeed;
+    frame.controlSpeed = record.controlSpeed;
+
+    frame.predicts.resize(record.predictCount);
+    for (int i = 0; i < record.predictCount; i++)
+    {
+      const RunLogPredict &predict = *(const RunLogPredict *)data;
+      PredictResult &result = frame.predicts[i];
+      result.type = predict.type;
+      result.label = predict.type >= 0 && predict.type < LABEL_COUNT ? LABEL_NAMES[predict.type] : "";
+      result.score = predict.score;
+      result.x = predict.x;
+      result.y = predict.y;
+      result.width = predict.width;
+      result.height = predict.height;
+      data += sizeof(RunLogPredict);
+    }
+    readEdge(data, record.edgeLeftCount, frame.edgeLeft);
+    readEdge(data, record.edgeRightCount, frame.edgeRight);
+
+    if (record.imageBytes == 0)
+      frame.image = cv::Mat();
+    else if (record.flags & RUNLOG_JPEG)
+      frame.image = cv::imdecode(cv::Mat(1, record.imageBytes, CV_8UC1, data), cv::IMREAD_UNCHANGED);
+    else
+      frame.image = cv::Mat(record.imageRows, record.imageCols, record.imageType, data);
+    return true;
+  }
+
+  void close()
+  {
+    if (_data != nullptr)
+      munmap(_data, _length);
+    if (_fd >= 0)
+      ::close(_fd);
+    _data = nullptr;
+    _fd = -1;
+    _length = 0;
+    _offsets.clear();
+  }
+
+private:
+  int _fd = -1;
+  uchar *_data = nullptr;
+  size_t _length = 0;
+  RunLogHeader _header = {};
+  std::vector<size_t> _offsets; // 各记录在文件中的偏移
+
+  static void readEdge(uchar *&data, int count, std::vector<POINT> &edge)
+  {
+    edge.resize(count);
+    for (int i = 0; i < count; i++)
+    {
+      const RunLogPoint &point = *(const RunLogPoint *)data;
+      edge[i] = POINT(point.x, point.y);
+      data += sizeof(RunLogPoint);
+    }
+  }
+};
@@ -0,0 +1,240 @@
+#pragma once
+
+#include "stage_queue.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <pthread.h>
+#include <sched.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 多级流水线执行器：每一级一个线程（可绑定CPU核），相邻两级之间为有界单生产者/单消费者队列
+ *
+ * 预分配depth个帧槽位在各级之间循环：首级从空闲队列取槽位，末级处理完后归还；
+ * 第N帧在后级处理时，第N+1帧可在前级处理。depth为在途帧数：越大吞吐越高，控制延迟越大（1：各级不重叠）
+ * 每帧记录各级开始/结束时刻，统计各级处理耗时、级间等待与端到端延迟
+ * @note 首级返回false表示输入结束，已在途的帧仍处理完；其余级返回false或stop()后，后续帧不再执行各级处理
+ */
+template <typename T>
+class StagedExecutor
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief 帧槽位
+   *
+   */
+  struct Slot
+  {
+    T data;
+    Clock::time_point origin;             // 端到端延迟起点：默认首级开始时刻，首级可改为采集时刻
+    std::vector<Clock::time_point> enter; // 各级开始时刻
+    std::vector<Clock::time_point> leave; // 各级结束时刻
+  };
+
+  ~StagedExecutor()
+  {
+    stop();
+    wait();
+  }
+
+  /**
+   * @brief 添加一级（按执行顺序，启动前调用）
+   *
+   * @param name 名称（统计输出/线程名）
+   * @param run 处理函数：false-结束
+   * @param core 绑定的CPU核（-1：不绑定）
+   */
+  void addStage(const std::string &name, std::function<bool(Slot &)> run, int core = -1)
+  {
+    Stage stage;
+    stage.name = name;
+    stage.run = run;
+    stage.core = core;
+    _stages.push_back(std::move(stage));
+  }
+
+  /**
+   * @brief 启动各级线程
+   *
+   * @param depth 在途帧数（帧槽位数）
+   */
+  void start(int depth)
+  {
+    int count = _stages.size();
+    depth = std::max(depth, 1);
+    _slots.clear();
+    _queues = std::vector<StageQueue<Slot *>>(count);
+    for (int i = 0; i < count; i++)
+      _queues[i].init(depth);
+    for (int i = 0; i < depth; i++)
+    {
+      _slots.push_back(std::make_unique<Slot>());
+      _slots[i]->enter.resize(count);
+      _slots[i]->leave.resize(count);
+      _queues[count - 1].push(_slots[i].get()); // 空闲队列：末级 -> 首级
+    }
+
+    _stop = false;
+    for (int i = 0; i < count; i++)
+    {
+      _stages[i].thread = std::thread([this, i] { stageLoop(i); });
+      pin(_stages[i]);
+    }
+  }
+
+  /**
+   * @brief 请求结束：首级不再取新帧
+   *
+   */
+  void stop() { _stop = true; }
+
+  /**
+   * @brief 等待各级线程退出
+   *
+   */
+  void wait()
+  {
+    for (int i = 0; i < _stages.size(); i++)
+    {
+      if (_stages[i].thread.joinable())
+        _stages[i].thread.join();
+    }
+  }
+
+  uint64_t frames() { return _frames; }             // 完成的帧数
+  double latencyLast() { return _latencyLast; }    // 最近一帧端到端延迟（ms）
+  double latencyMean() { return _frames ? _latencyTotal / _frames : 0; }
+  double latencyMax() { return _latencyMax; }
+
+  /**
+   * @brief 各级耗时与端到端延迟统计输出
+   *
+   */
+  void printStatistics()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::cout << "Pipeline frames: " << _frames << " latency mean: " << latencyMean()
+              << "ms max: " << _latencyMax << "ms";
+    if (_frames > 1)
+      std::cout << " throughput: "
+                << (_frames - 1) * 1000.0 /
+                       std::chrono::duration<double, std::milli>(_lastLeave - _firstLeave).count()
+                << "fps";
+    std::cout << std::endl;
+    for (int i = 0; i < _stages.size(); i++)
+    {
+      Stage &stage = _stages[i];
+      uint64_t n = std::max<uint64_t>(_frames, 1);
+      std::cout << "  [" << i << "] " << stage.name << " (core " << stage.core
+                << "): run mean: " << stage.runTotal / n << "ms max: " << stage.runMax
+                << "ms, wait mean: " << stage.waitTotal / n << "ms max: " << stage.waitMax
+                << "ms" << std::endl;
+    }
+  }
+
+private:
+  struct Stage
+  {
+    std::string name;
+    std::function<bool(Slot &)> run;
+    int core = -1;
+    std::thread thread;
+    double runTotal = 0, runMax = 0;   // 处理耗时（ms）
+    double waitTotal = 0, waitMax = 0; // 前一级结束到本级开始的等待（ms）
+  };
+
+  std::vector<Stage> _stages;
+  std::vector<std::unique_ptr<Slot>> _slots;
+  std::vector<StageQueue<Slot *>> _queues; // _queues[i]：第i级 -> 第i+1级（末级 -> 首级为空闲队列）
+  std::atomic<bool> _stop{false};
+
+  std::mutex _mutex; // 统计数据
+  uint64_t _frames = 0;
+  double _latencyTotal = 0, _latencyMax = 0, _latencyLast = 0;
+  Clock::time_point _firstLeave, _lastLeave;
+
+  void stageLoop(int index)
+  {
+    int count = _stages.size();
+    StageQueue<Slot *> &input = _queues[(index + count - 1) % count];
+    StageQueue<Slot *> &output = _queues[index];
+    Stage &stage = _stages[index];
+    Slot *slot;
+    while (true)
+    {
+      if (index == 0 && _stop)
+        break;
+      if (!input.pop(slot))
+        break;
+
+      slot->enter[index] = Clock::now();
+      if (index == 0)
+        slot->origin = slot->enter[0];
+      bool running = !_stop && stage.run(*slot);
+      slot->leave[index] = Clock::now();
+      if (!running)
+      {
+        if (index == 0) // 输入结束：当前槽位不再向后传递，在途帧由后续各级处理完
+          break;
+        _stop = true;
+      }
+
+      if (index == count - 1 && running)
+        account(*slot);
+      output.push(slot);
+    }
+    if (index < count - 1)
+      output.close(); // 通知后一级
+  }
+
+  /**
+   * @brief 末级：单帧统计
+   *
+   */
+  void account(Slot &slot)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    int count = _stages.size();
+    for (int i = 0; i < count; i++)
+    {
+      double run = std::chrono::duration<double, std::milli>(slot.leave[i] - slot.enter[i]).count();
+      _stages[i].runTotal += run;
+      _stages[i].runMax = std::max(_stages[i].runMax, run);
+      if (i > 0)
+      {
+        double wait = std::chrono::duration<double, std::milli>(slot.enter[i] - slot.leave[i - 1]).count();
+        _stages[i].waitTotal += wait;
+        _stages[i].waitMax = std::max(_stages[i].waitMax, wait);
+      }
+    }
+    _latencyLast = std::chrono::duration<double, std::milli>(slot.leave[count - 1] - slot.origin).count();
+    _latencyTotal += _latencyLast;
+    _latencyMax = std::max(_latencyMax, _latencyLast);
+    if (_frames == 0)
+      _firstLeave = slot.leave[count - 1];
+    _lastLeave = slot.leave[count - 1];
+    _frames++;
+  }
+
+  static void pin(Stage &stage)
+  {
+    pthread_setname_np(stage.thread.native_handle(), stage.name.substr(0, 15).c_str()); // 线程名最长15字节
+    if (stage.core < 0)
+      return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(stage.core, &set);
+    if (pthread_setaffinity_np(stage.thread.native_handle(), sizeof(set), &set) != 0)
+      std::cout << "Warning: stage [" << stage.name << "] pin to core " << stage.core
+                << " failed." << std::endl;
+  }
+};
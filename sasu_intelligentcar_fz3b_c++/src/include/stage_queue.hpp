@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 单生产者/单消费者的有界环形队列（无锁），用于流水线相邻两级之间传递帧槽位
+ *
+ * 队满时生产者等待、队空时消费者等待（先让出CPU，再短暂休眠），不丢帧；
+ * close()后消费者取完剩余元素即返回false
+ */
+template <typename T>
+class StageQueue
+{
+public:
+  /**
+   * @brief 设置容量（启动前调用）
+   *
+   */
+  void init(int capacity)
+  {
+    _items.assign(capacity, T());
+    _head.store(0, std::memory_order_relaxed);
+    _tail.store(0, std::memory_order_relaxed);
+    _closed.store(false, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief 生产者：入队，队满时等待
+   *
+   */
+  void push(const T &item)
+  {
+    uint64_t tail = _tail.load(std::memory_order_relaxed);
+    int spins = 0;
+    while (tail - _head.load(std::memory_order_acquire) >= _items.size())
+      wait(spins);
+    _items[tail % _items.size()] = item;
+    _tail.store(tail + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief 消费者：出队，队空时等待
+   *
+   * @return false 队列已关闭且为空
+   */
+  bool pop(T &item)
+  {
+    uint64_t head = _head.load(std::memory_order_relaxed);
+    int spins = 0;
+    while (_tail.load(std::memory_order_acquire) == head)
+    {
+      if (_closed.load(std::memory_order_acquire) &&
+          _tail.load(std::memory_order_acquire) == head)
+        return false;
+      wait(spins);
+    }
+    item = _items[head % _items.size()];
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief 生产者：不再入队
+   *
+   */
+  void close() { _closed.store(true, std::memory_order_release); }
+
+  int size()
+  {
+    return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+  }
+
+private:
+  std::vector<T> _items;
+  std::atomic<uint64_t> _head{0}; // 消费者：已出队的元素数
+  std::atomic<uint64_t> _tail{0}; // 生产者：已入队的元素数
+  std::atomic<bool> _closed{false};
+
+  static void wait(int &spins)
+  {
+    if (++spins < 64) // 相邻级通常很快完成：先让出CPU，再短暂休眠
+      std::this_thread::yield();
+    else
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+};
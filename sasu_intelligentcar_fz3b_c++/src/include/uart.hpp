@@ -1,4 +1,5 @@
 #include "common.hpp"
+#include "profiler.hpp"
 #include "stop_watch.hpp"
 #include <iostream>
 #include <libserial/SerialPort.h>
@@ -158,6 +159,7 @@ public:
    */
   void carControl(float speed, uint16_t servoPwm)
   {
+    PROFILE_SCOPE("uart");
     if (isOpen)
     {
       Bint32_Union bint32_Union;
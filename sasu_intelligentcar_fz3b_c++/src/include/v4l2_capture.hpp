@@ -0,0 +1,312 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <errno.h>
+#include <fcntl.h>
+#include <iostream>
+#include <linux/videodev2.h>
+#include <mutex>
+#include <opencv2/opencv.hpp>
+#include <poll.h>
+#include <string>
+#include <thread>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * @brief V4L2原生采集：mmap驱动缓存，零拷贝输出图像帧
+ *
+ * YUYV：输出CV_8UC2图像，直接指向驱动缓存（不拷贝、不转换）
+ * MJPEG：输出解码后的BGR图像（解码不可避免的一次写入）
+ * @note 每帧附带一个缓存占用标记（lease），只要下游仍持有该标记，驱动缓存保持出队、
+ *       内容不会被改写；最后一个标记释放时由其删除器归还驱动（任意线程，不依赖跨线程的引用计数查询）
+ *       cv::Mat的浅拷贝不持有标记：跨帧保留图像须同时持有lease，或clone()
+ *       缓存映射随最后一个标记释放（close()后仍被持有的缓存延迟munmap）
+ *       无摄像头时可加载vivid虚拟摄像头测试：sudo modprobe vivid
+ */
+class V4l2Capture
+{
+public:
+  V4l2Capture(){};
+  ~V4l2Capture() { close(); };
+
+  /**
+   * @brief 打开设备并开始采集
+   *
+   * @param device 设备路径：/dev/videoX
+   * @param width 图像宽度
+   * @param height 图像高度
+   * @param mjpeg true：MJPEG；false：YUYV
+   * @param buffers 驱动缓存队列深度（需大于下游同时持有的帧数+1）
+   * @return int 0：成功
+   */
+  int open(std::string device, int width, int height, bool mjpeg, int buffers)
+  {
+    close();
+    if (buffers < 2)
+      buffers = 2;
+
+    _fd = ::open(device.c_str(), O_RDWR | O_NONBLOCK);
+    if (_fd < 0)
+    {
+      std::cout << "V4L2 open failed: " << device << " " << strerror(errno) << std::endl;
+      return -1;
+    }
+    _session = std::make_shared<Session>();
+    _session->fd = _fd;
+
+    v4l2_format format;
+    memset(&format, 0, sizeof(format));
+    format.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    format.fmt.pix.width = width;
+    format.fmt.pix.height = height;
+    format.fmt.pix.pixelformat = mjpeg ? V4L2_PIX_FMT_MJPEG : V4L2_PIX_FMT_YUYV;
+    format.fmt.pix.field = V4L2_FIELD_NONE;
+    if (xioctl(VIDIOC_S_FMT, &format) < 0)
+      return fail("VIDIOC_S_FMT");
+    if (format.fmt.pix.pixelformat != (mjpeg ? V4L2_PIX_FMT_MJPEG : V4L2_PIX_FMT_YUYV))
+    {
+      std::cout << "V4L2 pixel format not supported: " << (mjpeg ? "MJPEG" : "YUYV") << std::endl;
+      close();
+      return -1;
+    }
+    _mjpeg = mjpeg;
+    _width = format.fmt.pix.width; // 驱动可能调整分辨率
+    _height = format.fmt.pix.height;
+    _stride = format.fmt.pix.bytesperline ? format.fmt.pix.bytesperline : _width * 2;
+
+    v4l2_requestbuffers request;
+    memset(&request, 0, sizeof(request));
+    request.count = buffers;
+    request.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    request.memory = V4L2_MEMORY_MMAP;
+    if (xioctl(VIDIOC_REQBUFS, &request) < 0)
+      return fail("VIDIOC_REQBUFS");
+    if (request.count < 2)
+    {
+      std::cout << "V4L2 insufficient buffers: " << request.count << std::endl;
+      close();
+      return -1;
+    }
+
+    for (uint32_t i = 0; i < request.count; i++)
+    {
+      v4l2_buffer buffer;
+      memset(&buffer, 0, sizeof(buffer));
+      buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+      buffer.memory = V4L2_MEMORY_MMAP;
+      buffer.index = i;
+      if (xioctl(VIDIOC_QUERYBUF, &buffer) < 0)
+        return fail("VIDIOC_QUERYBUF");
+      void *start = mmap(NULL, buffer.length, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, buffer.m.offset);
+      if (start == MAP_FAILED)
+        return fail("mmap");
+      _mappings.push_back(std::make_shared<Mapping>(start, buffer.length));
+      if (xioctl(VIDIOC_QBUF, &buffer) < 0)
+        return fail("VIDIOC_QBUF");
+    }
+
+    v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    if (xioctl(VIDIOC_STREAMON, &type) < 0)
+      return fail("VIDIOC_STREAMON");
+
+    v4l2_streamparm stream;
+    memset(&stream, 0, sizeof(stream));
+    stream.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    if (xioctl(VIDIOC_G_PARM, &stream) == 0 && stream.parm.capture.timeperframe.numerator)
+      _fps = (double)stream.parm.capture.timeperframe.denominator / stream.parm.capture.timeperframe.numerator;
+
+    std::cout << "V4L2 Param: " << (mjpeg ? "MJPEG" : "YUYV") << " width = " << _width
+              << " height = " << _height << " frame rate = " << _fps
+              << " buffers = " << request.count << std::endl;
+    return 0;
+  }
+
+  /**
+   * @brief 读取一帧
+   *
+   * @param frame 输出图像：YUYV为指向驱动缓存的CV_8UC2图像，MJPEG为解码后的BGR图像
+   * @param lease 缓存占用标记：持有期间图像内容有效
+   * @return true 成功
+   */
+  bool read(cv::Mat &frame, std::shared_ptr<void> &lease)
+  {
+    if (_fd < 0)
+      return false;
+
+    frame.release();
+    lease = nullptr; // 调用方不再持有上一帧：最后一个标记释放时归还驱动
+
+    v4l2_buffer buffer;
+    for (int retry = 0;; retry++)
+    {
+      pollfd fds = {_fd, POLLIN, 0};
+      int ret = poll(&fds, 1, 2000);
+      if (ret <= 0)
+      {
+        std::cout << "V4L2 read timeout (buffers held downstream: " << held() << "/"
+                  << _mappings.size() << ")." << std::endl;
+        return false;
+      }
+
+      memset(&buffer, 0, sizeof(buffer));
+      buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+      buffer.memory = V4L2_MEMORY_MMAP;
+      if (xioctl(VIDIOC_DQBUF, &buffer) < 0)
+        return false;
+      if (!(buffer.flags & V4L2_BUF_FLAG_ERROR))
+        break;
+
+      // 传输出错的帧（数据可能不完整）：直接归还驱动，读取下一帧
+      _errors++;
+      xioctl(VIDIOC_QBUF, &buffer);
+      if (retry >= (int)_mappings.size())
+      {
+        std::cout << "V4L2 read failed: corrupted frames." << std::endl;
+        return false;
+      }
+    }
+
+    if ((buffer.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) == V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC)
+      _timestamp = std::chrono::steady_clock::time_point(
+          std::chrono::seconds(buffer.timestamp.tv_sec) +
+          std::chrono::microseconds(buffer.timestamp.tv_usec)); // 驱动时间戳（CLOCK_MONOTONIC）
+    else
+      _timestamp = std::chrono::steady_clock::now();
+    _sequence = buffer.sequence;
+
+    std::shared_ptr<Mapping> &mapping = _mappings[buffer.index];
+    if (_mjpeg) // 解码输出独立内存，缓存立即归还
+    {
+      frame = cv::imdecode(cv::Mat(1, buffer.bytesused, CV_8UC1, mapping->start), cv::IMREAD_COLOR);
+      requeue(*_session, buffer.index);
+    }
+    else
+    {
+      frame = cv::Mat(_height, _width, CV_8UC2, mapping->start, _stride); // 零拷贝
+      _session->held++;
+      std::shared_ptr<Session> session = _session;
+      uint32_t index = buffer.index;
+      lease = std::shared_ptr<void>(mapping->start, [session, mapping, index](void *) {
+        requeue(*session, index);
+        session->held--;
+      }); // 删除器持有映射：close()后仍被持有的缓存延迟munmap
+    }
+    return !frame.empty();
+  }
+
+  /**
+   * @brief 停止采集并释放驱动缓存
+   *
+   * @note 下游仍持有的缓存先等待释放（最多200ms），超时则延迟到最后一个标记释放时munmap，
+   *       已交出的零拷贝图像在持有lease期间始终有效
+   */
+  void close()
+  {
+    if (_fd < 0)
+      return;
+    v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    xioctl(VIDIOC_STREAMOFF, &type);
+    for (int i = 0; i < 200 && held() > 0; i++)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    if (held() > 0)
+      std::cout << "V4L2 close: " << held() << " buffers still held downstream, unmap deferred." << std::endl;
+    {
+      std::lock_guard<std::mutex> lock(_session->mutex);
+      _session->fd = -1; // 之后释放的标记不再归还
+    }
+    _session = nullptr;
+    _mappings.clear(); // 无其他持有者的缓存在此munmap
+    ::close(_fd);
+    _fd = -1;
+  }
+
+  bool is_open() { return _fd >= 0; }
+  std::chrono::steady_clock::time_point timestamp() { return _timestamp; } // 最近一帧的驱动时间戳
+  uint32_t sequence() { return _sequence; }                                 // 最近一帧的驱动帧序号
+  double fps() { return _fps; }
+  uint64_t errors() { return _errors; } // 传输出错而丢弃的帧数
+
+private:
+  /**
+   * @brief 驱动缓存映射：析构时munmap
+   *
+   */
+  struct Mapping
+  {
+    void *start;
+    size_t length;
+    Mapping(void *start, size_t length) : start(start), length(length) {}
+    ~Mapping() { munmap(start, length); }
+  };
+
+  /**
+   * @brief 采集会话：标记的删除器经由它归还缓存，与close()互斥
+   *
+   */
+  struct Session
+  {
+    std::mutex mutex;         // 归还与关闭互斥：不向已关闭的fd归还
+    int fd = -1;              // 设备（-1：已关闭）
+    std::atomic<int> held{0}; // 下游仍持有的缓存数
+  };
+
+  int _fd = -1;
+  bool _mjpeg = false;
+  int _width = 0;
+  int _height = 0;
+  int _stride = 0;
+  double _fps = 0;
+  uint32_t _sequence = 0;
+  std::chrono::steady_clock::time_point _timestamp;
+  std::vector<std::shared_ptr<Mapping>> _mappings;
+  std::shared_ptr<Session> _session;
+  uint64_t _errors = 0;
+
+  /**
+   * @brief 下游仍持有的缓存数
+   *
+   */
+  int held() { return _session ? _session->held.load() : 0; }
+
+  /**
+   * @brief 缓存归还驱动（标记的删除器，可在任意线程调用）
+   *
+   */
+  static void requeue(Session &session, uint32_t index)
+  {
+    std::lock_guard<std::mutex> lock(session.mutex);
+    if (session.fd < 0)
+      return;
+    v4l2_buffer buffer;
+    memset(&buffer, 0, sizeof(buffer));
+    buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buffer.memory = V4L2_MEMORY_MMAP;
+    buffer.index = index;
+    if (xioctl(session.fd, VIDIOC_QBUF, &buffer) < 0)
+      std::cout << "V4L2 requeue failed: " << strerror(errno) << std::endl;
+  }
+
+  int xioctl(unsigned long request, void *arg) { return xioctl(_fd, request, arg); }
+
+  static int xioctl(int fd, unsigned long request, void *arg)
+  {
+    int ret;
+    do
+    {
+      ret = ioctl(fd, request, arg);
+    } while (ret < 0 && errno == EINTR);
+    return ret;
+  }
+
+  int fail(const char *what)
+  {
+    std::cout << "V4L2 " << what << " failed: " << strerror(errno) << std::endl;
+    close();
+    return -1;
+  }
+};
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <pthread.h>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 固定线程数的工作线程池：单帧内并行执行一组相互独立的任务
+ *
+ * run()阻塞到本组任务全部完成，调用线程同时参与执行；任务按序号动态领取
+ * @note 仅供单一调用线程使用（每帧一组任务），任务之间不得共享可写数据
+ */
+class WorkerPool
+{
+public:
+  ~WorkerPool() { stop(); }
+
+  /**
+   * @brief 启动工作线程
+   *
+   * @param threads 工作线程数（不含调用线程），0：run()在调用线程中串行执行
+   */
+  void init(int threads)
+  {
+    stop();
+    _stop = false;
+    uint64_t generation = _generation;
+    for (int i = 0; i < threads; i++)
+      _workers.emplace_back([this, generation] { workerLoop(generation); });
+  }
+
+  /**
+   * @brief 并行执行task(0) ~ task(count - 1)，全部完成后返回
+   *
+   */
+  void run(int count, const std::function<void(int)> &task)
+  {
+    if (_workers.empty() || count <= 1)
+    {
+      for (int i = 0; i < count; i++)
+        task(i);
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _task = &task;
+      _count = count;
+      _next.store(0, std::memory_order_relaxed);
+      _active = _workers.size();
+      _generation++;
+    }
+    _start.notify_all();
+
+    execute(task, count);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _done.wait(lock, [this] { return _active == 0; });
+    _task = nullptr;
+  }
+
+  int size(void) const { return _workers.size(); } // 工作线程数
+
+private:
+  std::vector<std::thread> _workers;
+  std::mutex _mutex;
+  std::condition_variable _start; // 新一组任务
+  std::condition_variable _done;  // 工作线程全部完成
+  const std::function<void(int)> *_task = nullptr;
+  int _count = 0;
+  std::atomic<int> _next{0}; // 下一个待领取的任务序号
+  int _active = 0;           // 本组未完成的工作线程数
+  uint64_t _generation = 0;  // 任务组序号
+  bool _stop = false;
+
+  void execute(const std::function<void(int)> &task, int count)
+  {
+    for (int i = _next.fetch_add(1, std::memory_order_relaxed); i < count;
+         i = _next.fetch_add(1, std::memory_order_relaxed))
+      task(i);
+  }
+
+  void workerLoop(uint64_t generation)
+  {
+    pthread_setname_np(pthread_self(), "worker");
+    while (true)
+    {
+      const std::function<void(int)> *task;
+      int count;
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _start.wait(lock, [&] { return _stop || _generation != generation; });
+        if (_stop)
+          return;
+        generation = _generation;
+        task = _task;
+        count = _count;
+      }
+
+      execute(*task, count);
+
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (--_active == 0)
+        _done.notify_one();
+    }
+  }
+
+  void stop(void)
+  {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stop = true;
+    }
+    _start.notify_all();
+    for (int i = 0; i < _workers.size(); i++)
+      _workers[i].join();
+    _workers.clear();
+  }
+};
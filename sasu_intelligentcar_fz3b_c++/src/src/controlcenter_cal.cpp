@@ -197,7 +197,7 @@ public:
    *
    * @param centerImage 需要叠加显示的图像
    */
-  void drawImage(TrackRecognition track, Mat &centerImage) {
+  void drawImage(const TrackRecognition &track, Mat &centerImage) {
     // 赛道边缘绘制
     for (int i = 0; i < track.pointsEdgeLeft.size(); i++) {
       circle(centerImage,
@@ -248,7 +248,7 @@ private:
    * @param pointsEdgeLeft
    * @return uint16_t
    */
-  uint16_t searchBreakLeftDown(vector<POINT> pointsEdgeLeft) {
+  uint16_t searchBreakLeftDown(const vector<POINT> &pointsEdgeLeft) {
     uint16_t counter = 0;
 
     for (int i = 0; i < pointsEdgeLeft.size() - 10; i++) {
@@ -270,7 +270,7 @@ private:
    * @param pointsEdgeRight
    * @return uint16_t
    */
-  uint16_t searchBreakRightDown(vector<POINT> pointsEdgeRight) {
+  uint16_t searchBreakRightDown(const vector<POINT> &pointsEdgeRight) {
     uint16_t counter = 0;
 
     for (int i = 0; i < pointsEdgeRight.size() - 10; i++) // 寻找左边跳变点
@@ -294,7 +294,7 @@ private:
    * @param side 单边类型：左边0/右边1
    * @return vector<POINT>
    */
-  vector<POINT> centerCompute(vector<POINT> pointsEdge, int side) {
+  vector<POINT> centerCompute(const vector<POINT> &pointsEdge, int side) {
     int step = 4;                    // 间隔尺度
     int offsetWidth = COLSIMAGE / 2; // 首行偏移量
     int offsetHeight = 0;            // 纵向偏移量
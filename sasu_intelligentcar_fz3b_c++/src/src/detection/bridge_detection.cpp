@@ -27,7 +27,7 @@
 #include <opencv2/highgui.hpp>
 #include <opencv2/opencv.hpp>
 #include "../../include/common.hpp"
-#include "../../include/predictor.hpp"
+#include "../../include/frame_context.hpp"
 #include "../recognition/track_recognition.cpp"
 
 using namespace cv;
@@ -47,7 +47,16 @@ public:
         bridgeEnable = false; // 桥区域使能标志
     }
 
-    bool bridgeDetection(TrackRecognition &track, vector<PredictResult> predict)
+    /**
+     * @brief 非空闲：桥区域使能或标志计数中
+     *
+     */
+    bool busy(void)
+    {
+        return bridgeEnable || counterRec > 0;
+    }
+
+    bool bridgeDetection(TrackRecognition &track, const FrameContext &frame)
     {
         if (bridgeEnable) // 进入桥梁
         {
@@ -68,16 +77,10 @@ public:
         }
         else // 检测桥
         {
-            for (int i = 0; i < predict.size(); i++)
-            {
-                if (predict[i].label == LABEL_BRIDGE)
-                {
-                    counterRec++;
-                    break;
-                }
-            }
+            if (frame.predictsFresh && frame.predicts.has(LABEL_BRIDGE)) // 同一推理结果只计一次
+                counterRec++;
 
-            if (counterRec)
+            if (counterRec && frame.predictsFresh) // 场次按推理结果计
             {
                 counterSession++;
                 if (counterRec >= 4 && counterSession < 8)
@@ -102,7 +105,7 @@ public:
      * @brief 识别结果图像绘制
      *
      */
-    void drawImage(TrackRecognition track, Mat &image)
+    void drawImage(const TrackRecognition &track, Mat &image)
     {
         // 赛道边缘
         for (int i = 0; i < track.pointsEdgeLeft.size(); i++)
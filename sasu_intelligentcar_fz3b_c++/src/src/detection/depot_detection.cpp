@@ -11,7 +11,7 @@
 #pragma once
 
 #include "../../include/common.hpp"
-#include "../../include/predictor.hpp"
+#include "../../include/frame_context.hpp"
 #include "../recognition/track_recognition.cpp"
 #include <cmath>
 #include <fstream>
@@ -50,13 +50,22 @@ public:
     counterImmunity = 0;
   }
 
+  /**
+   * @brief 非空闲：维修厂处理中、屏蔽计数或标志计数中
+   *
+   */
+  bool busy(void) {
+    return depotStep != DepotStep::DepotNone || counterImmunity <= 20 ||
+           counterRec > 0;
+  }
+
   /**
    * @brief 维修厂检测与路径规划
    *
    * @param track 赛道识别结果
    * @param detection AI检测结果
    */
-  bool depotDetection(TrackRecognition &track, vector<PredictResult> predict) {
+  bool depotDetection(TrackRecognition &track, const FrameContext &frame) {
     _pointNearCone = POINT(0, 0);
     _distance = 0;
     pointEdgeDet.clear();
@@ -66,14 +75,10 @@ public:
     switch (depotStep) {
     case DepotStep::DepotNone: //[01] 维修厂标志检测
       if (counterImmunity > 20) {
-        for (int i = 0; i < predict.size(); i++) {
-          if (predict[i].label == LABEL_TRACTOR) // 拖拉机标志检测
-          {
-            counterRec++;
-            break;
-          }
-        }
-        if (counterRec) {
+        if (frame.predictsFresh &&
+            frame.predicts.has(LABEL_TRACTOR)) // 拖拉机标志检测：同一推理结果只计一次
+          counterRec++;
+        if (counterRec && frame.predictsFresh) { // 场次按推理结果计
           counterSession++;
           if (counterRec > 3 && counterSession < 8) {
             depotStep = DepotStep::DepotEnable; // 维修厂使能
@@ -96,7 +101,7 @@ public:
         return false;
       }
 
-      searchCones(predict);
+      searchCones(frame.predicts);
       _pointNearCone =
           searchNearestCone(track.pointsEdgeLeft, pointEdgeDet); // 搜索右下锥桶
       if (_pointNearCone.x >
@@ -158,7 +163,7 @@ public:
         }
       }
 
-      searchCones(predict);            // 计算锥桶的坐标
+      searchCones(frame.predicts);            // 计算锥桶的坐标
       searchHighestCone(pointEdgeDet); // 搜索顶点锥桶
       if (heighestCone.x > 0 && heighestCone.y > 0) {
         if (heighestCone.y >= COLSIMAGE / 3) // 顶角锥桶靠近右边→继续右转
@@ -262,7 +267,7 @@ public:
    * @brief 识别结果图像绘制
    *
    */
-  void drawImage(TrackRecognition track, Mat &image) {
+  void drawImage(const TrackRecognition &track, Mat &image) {
     // 绘制锥桶坐标
     for (int i = 0; i < pointEdgeDet.size(); i++) {
       circle(image, Point(pointEdgeDet[i].y, pointEdgeDet[i].x), 2,
@@ -342,14 +347,12 @@ private:
    * @param predict AI检测结果
    * @return vector<POINT>
    */
-  void searchCones(vector<PredictResult> predict) {
+  void searchCones(const PredictIndex &predict) {
     pointEdgeDet.clear();
-    for (int i = 0; i < predict.size(); i++) {
-      if (predict[i].label == LABEL_CONE) // 锥桶检测
-      {
-        pointEdgeDet.push_back(POINT(predict[i].y + predict[i].height / 2,
-                                     predict[i].x + predict[i].width / 2));
-      }
+    const vector<PredictResult> &cones = predict[LABEL_CONE]; // 锥桶检测
+    for (int i = 0; i < cones.size(); i++) {
+      pointEdgeDet.push_back(POINT(cones[i].y + cones[i].height / 2,
+                                   cones[i].x + cones[i].width / 2));
     }
   }
 
@@ -360,8 +363,8 @@ private:
    * @param predict AI检测结果
    * @return POINT
    */
-  POINT searchNearestCone(vector<POINT> pointsEdgeLeft,
-                          vector<POINT> pointsCone) {
+  POINT searchNearestCone(const vector<POINT> &pointsEdgeLeft,
+                          const vector<POINT> &pointsCone) {
     POINT point(0, 0);
     double disMin = 50; // 右边缘锥桶离赛道左边缘最小距离
 
@@ -389,7 +392,7 @@ private:
    * @param predict AI检测结果
    * @return POINT
    */
-  void searchHighestCone(vector<POINT> pointsCone) {
+  void searchHighestCone(const vector<POINT> &pointsCone) {
     heighestCone = POINT(0, 0);
     if (pointsCone.size() <= 0)
       return;
@@ -407,7 +410,7 @@ private:
    * @param predict AI检测结果
    * @return POINT
    */
-  vector<POINT> searchLeftCones(vector<POINT> pointsCone) {
+  vector<POINT> searchLeftCones(const vector<POINT> &pointsCone) {
     vector<POINT> points;
     if (pointsCone.size() <= 0)
       return points;
@@ -28,7 +28,7 @@
 #include <opencv2/highgui.hpp>
 #include <opencv2/opencv.hpp>
 #include "../../include/common.hpp"
-#include "../../include/predictor.hpp"
+#include "../../include/frame_context.hpp"
 #include "../recognition/track_recognition.cpp"
 
 using namespace cv;
@@ -46,23 +46,32 @@ public:
         farmlandStep = FarmlandStep::None;
     }
 
+    /**
+     * @brief 非空闲：农田区域处理中或标志计数中
+     *
+     */
+    bool busy(void)
+    {
+        return farmlandStep != FarmlandStep::None || counterRec > 0;
+    }
+
     /**
      * @brief 加油站检测与路径规划
      *
      * @param track 赛道识别结果
      * @param detection AI检测结果
      */
-    bool farmlandDetection(TrackRecognition &track, vector<PredictResult> predict)
+    bool farmlandDetection(TrackRecognition &track, const FrameContext &frame)
     {
         indexDebug = 0;
         switch (farmlandStep)
         {
         case FarmlandStep::None: //[01] 农田区域检测
-            searchCorn(predict); // 玉米检测
-            if (pointCorn.x > 0 || pointCorn.y > 0)
+            searchCorn(frame.predicts); // 玉米检测
+            if (frame.predictsFresh && (pointCorn.x > 0 || pointCorn.y > 0)) // 同一推理结果只计一次
                 counterRec++;
 
-            if (counterRec)
+            if (counterRec && frame.predictsFresh) // 场次按推理结果计
             {
                 counterSession++;
                 if (counterRec > 4 && counterSession < 8)
@@ -119,8 +128,8 @@ public:
             }
             conesEdgeLeft.clear();
             conesEdgeRight.clear();
-            searchCorn(predict);                                   // 玉米检测
-            searchCones(predict);                                  // 检索锥桶位置
+            searchCorn(frame.predicts);                                   // 玉米检测
+            searchCones(frame.predicts);                                  // 检索锥桶位置
             int breakLeft = searchBreakLeft(track.pointsEdgeLeft); // Track边缘校验
             if (breakLeft > 0)
             {
@@ -246,8 +255,8 @@ public:
 
             conesEdgeLeft.clear();
             conesEdgeRight.clear();
-            searchCorn(predict);                          // 玉米检测
-            searchCones(predict);                         // 检索锥桶位置
+            searchCorn(frame.predicts);                          // 玉米检测
+            searchCones(frame.predicts);                         // 检索锥桶位置
             conesEdgeLeft.push_back(POINT(0, 0));         // 左下边缘点
             conesEdgeRight.push_back(POINT(0, 0));        // 右下边缘点
             for (int i = 0; i < pointEdgeDet.size(); i++) // 第一行边缘点搜索
@@ -352,7 +361,7 @@ public:
      * @brief 识别结果图像绘制
      *
      */
-    void drawImage(TrackRecognition track, Mat &image)
+    void drawImage(const TrackRecognition &track, Mat &image)
     {
         // 绘制4象限分割线
         line(image, Point(0, image.rows / 2), Point(image.cols, image.rows / 2), Scalar(255, 255, 255), 1);
@@ -431,16 +440,14 @@ private:
      *
      * @param predict AI检测结果
      */
-    void searchCones(vector<PredictResult> predict)
+    void searchCones(const PredictIndex &predict)
     {
         // AI结果检索
         pointEdgeDet.clear();
-        for (int i = 0; i < predict.size(); i++)
+        const vector<PredictResult> &cones = predict[LABEL_CONE]; // 锥桶检测
+        for (int i = 0; i < cones.size(); i++)
         {
-            if (predict[i].label == LABEL_CONE) // 锥桶检测
-            {
-                pointEdgeDet.push_back(POINT(predict[i].y + predict[i].height / 2, predict[i].x + predict[i].width / 2));
-            }
+            pointEdgeDet.push_back(POINT(cones[i].y + cones[i].height / 2, cones[i].x + cones[i].width / 2));
         }
     }
 
@@ -451,7 +458,7 @@ private:
      * @param pointLD 左下点
      * @param pointRD 右下点
      */
-    void searchConesEdge(vector<POINT> cones)
+    void searchConesEdge(const vector<POINT> &cones)
     {
         vector<POINT> pointsCones = cones;
         if (conesEdgeLeft.size() == 0 && conesEdgeRight.size() == 0) // 未搜索到起点
@@ -519,16 +526,17 @@ private:
      *
      * @param predict
      */
-    void searchCorn(vector<PredictResult> predict)
+    void searchCorn(const PredictIndex &predict)
     {
         POINT corn = POINT(0, 0);
         int distance = COLSIMAGE / 2;
-        for (int i = 0; i < predict.size(); i++)
+        const vector<PredictResult> &corns = predict[LABEL_CORN]; // 玉米检测
+        for (int i = 0; i < corns.size(); i++)
         {
-            if (predict[i].label == LABEL_CORN && abs(predict[i].x + predict[i].width / 2 - COLSIMAGE / 2) < distance) // 玉米检测
+            if (abs(corns[i].x + corns[i].width / 2 - COLSIMAGE / 2) < distance)
             {
-                corn = POINT(predict[i].y + predict[i].height, predict[i].x + predict[i].width / 2);
-                distance = abs(predict[i].x + predict[i].width / 2 - COLSIMAGE / 2);
+                corn = POINT(corns[i].y + corns[i].height, corns[i].x + corns[i].width / 2);
+                distance = abs(corns[i].x + corns[i].width / 2 - COLSIMAGE / 2);
             }
         }
 
@@ -541,7 +549,7 @@ private:
      * @param pointsEdgeLeft
      * @return uint16_t
      */
-    uint16_t searchBreakLeft(vector<POINT> pointsEdgeLeft)
+    uint16_t searchBreakLeft(const vector<POINT> &pointsEdgeLeft)
     {
         if (pointsEdgeLeft.size() < 10)
             return 0;
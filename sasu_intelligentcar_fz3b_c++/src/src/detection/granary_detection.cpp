@@ -26,7 +26,7 @@
 #include <opencv2/highgui.hpp>
 #include <opencv2/opencv.hpp>
 #include "../../include/common.hpp"
-#include "../../include/predictor.hpp"
+#include "../../include/frame_context.hpp"
 #include "../recognition/track_recognition.cpp"
 
 using namespace cv;
@@ -52,13 +52,22 @@ public:
         numGranary = 0;
     }
 
+    /**
+     * @brief 非空闲：粮仓处理中或标志计数中
+     *
+     */
+    bool busy(void)
+    {
+        return granaryStep != GranaryStep::None || counterRec > 0;
+    }
+
     /**
      * @brief 粮仓区域检测与路径规划
      *
      * @param track 赛道识别结果
      * @param detection AI检测结果
      */
-    bool granaryDetection(TrackRecognition &track, vector<PredictResult> predict)
+    bool granaryDetection(TrackRecognition &track, const FrameContext &frame)
     {
         slowDown = false;
         _pointNearCone = POINT(0, 0);
@@ -68,12 +77,12 @@ public:
         {
         case GranaryStep::None: //[01] 粮仓标志检测
         {
-            vector<POINT> granarys = searchGranary(predict); // 粮仓标志检测
-            if (granarys.size() > 0)
+            vector<POINT> granarys = searchGranary(frame.predicts); // 粮仓标志检测
+            if (frame.predictsFresh && granarys.size() > 0) // 同一推理结果只计一次
                 counterRec++;
-            if (granarys.size() > 1)
+            if (frame.predictsFresh && granarys.size() > 1)
                 numGranary++;
-            if (counterRec)
+            if (counterRec && frame.predictsFresh) // 场次按推理结果计
             {
                 counterSession++;
                 if (counterRec >= 2 && counterSession < 8)
@@ -94,12 +103,12 @@ public:
 
         case GranaryStep::Enable: //[02] 粮仓使能
         {
-            vector<POINT> granarys = searchGranary(predict); // 搜索粮仓标志
-            if (granarys.size() > 1)
+            vector<POINT> granarys = searchGranary(frame.predicts); // 搜索粮仓标志
+            if (frame.predictsFresh && granarys.size() > 1)
                 numGranary++;
             if (granarys.size() <= 0) // 离开粮仓标志后|开始入站搜索
             {
-                vector<POINT> pointsCone = searchCones(predict);
+                vector<POINT> pointsCone = searchCones(frame.predicts);
                 _pointNearCone = searchNearestCone(track.pointsEdgeLeft, pointsCone); // 搜索右下锥桶
                 if (_pointNearCone.x > ROWSIMAGE * 0.12)                              // 当车辆开始靠近右边锥桶：准备入库
                 {
@@ -126,7 +135,7 @@ public:
         {
             if (track.pointsEdgeLeft.size() > ROWSIMAGE / 2) // 第一阶段：当赛道边缘存在时
             {
-                vector<POINT> pointsCone = searchCones(predict);                      // 计算锥桶的坐标
+                vector<POINT> pointsCone = searchCones(frame.predicts);                      // 计算锥桶的坐标
                 _pointNearCone = searchNearestCone(track.pointsEdgeLeft, pointsCone); // 搜索右下锥桶
                 if (_pointNearCone.x > 0)                                             // 坐标有效
                 {
@@ -154,7 +163,7 @@ public:
             }
             else // 第二阶段：检查右下锥桶坐标满足巡航条件
             {
-                vector<POINT> pointsCone = searchCones(predict);       // 计算锥桶的坐标
+                vector<POINT> pointsCone = searchCones(frame.predicts);       // 计算锥桶的坐标
                 POINT coneRightDown = searchRightDownCone(pointsCone); // 右下方锥桶
                 _pointNearCone = coneRightDown;
                 counterSession++;
@@ -198,7 +207,7 @@ public:
 
         case GranaryStep::Cruise: //[04] 巡航使能
         {
-            vector<POINT> pointsCone = searchCones(predict);      // 计算锥桶的坐标
+            vector<POINT> pointsCone = searchCones(frame.predicts);      // 计算锥桶的坐标
             vector<POINT> conesLeft = searchLeftCone(pointsCone); // 搜索左方锥桶
 
             // if (pointsCone.size() < 2 && track.pointsEdgeLeft.size() > ROWSIMAGE / 2 && track.pointsEdgeRight.size() > ROWSIMAGE / 2)
@@ -283,7 +292,7 @@ public:
         }
         case GranaryStep::Exit: //[05] 出站使能
         {
-            vector<POINT> pointsCone = searchCones(predict);  // 计算锥桶的坐标
+            vector<POINT> pointsCone = searchCones(frame.predicts);  // 计算锥桶的坐标
             POINT coneLeftUp = searchRightUpCone(pointsCone); // 搜索右上方的锥桶用于补线
 
             if (track.pointsEdgeLeft.size() > ROWSIMAGE / 4 && track.pointsEdgeRight.size() > ROWSIMAGE / 4 && pointsCone.size() < 3)
@@ -333,7 +342,7 @@ public:
      * @brief 识别结果图像绘制
      *
      */
-    void drawImage(TrackRecognition track, Mat &image)
+    void drawImage(const TrackRecognition &track, Mat &image)
     {
         for (int i = 0; i < pointEdgeDet.size(); i++)
         {
@@ -401,15 +410,13 @@ private:
      * @param predict AI检测结果
      * @return vector<POINT>
      */
-    vector<POINT> searchCones(vector<PredictResult> predict)
+    vector<POINT> searchCones(const PredictIndex &predict)
     {
         vector<POINT> cones;
-        for (int i = 0; i < predict.size(); i++)
+        const vector<PredictResult> &results = predict[LABEL_CONE]; // 锥桶检测
+        for (int i = 0; i < results.size(); i++)
         {
-            if (predict[i].label == LABEL_CONE) // 锥桶检测
-            {
-                cones.push_back(POINT(predict[i].y + predict[i].height / 2, predict[i].x + predict[i].width / 2));
-            }
+            cones.push_back(POINT(results[i].y + results[i].height / 2, results[i].x + results[i].width / 2));
         }
 
         pointEdgeDet = cones;
@@ -422,15 +429,13 @@ private:
      * @param predict
      * @return vector<POINT>
      */
-    vector<POINT> searchGranary(vector<PredictResult> predict)
+    vector<POINT> searchGranary(const PredictIndex &predict)
     {
         vector<POINT> granarys;
-        for (int i = 0; i < predict.size(); i++)
+        const vector<PredictResult> &results = predict[LABEL_GRANARY];
+        for (int i = 0; i < results.size(); i++)
         {
-            if (predict[i].label == LABEL_GRANARY)
-            {
-                granarys.push_back(POINT(predict[i].y + predict[i].height / 2, predict[i].x + predict[i].width / 2));
-            }
+            granarys.push_back(POINT(results[i].y + results[i].height / 2, results[i].x + results[i].width / 2));
         }
 
         return granarys;
@@ -443,7 +448,7 @@ private:
      * @param predict AI检测结果
      * @return POINT
      */
-    POINT searchNearestCone(vector<POINT> pointsEdgeLeft, vector<POINT> pointsCone)
+    POINT searchNearestCone(const vector<POINT> &pointsEdgeLeft, const vector<POINT> &pointsCone)
     {
         POINT point(0, 0);
         double disMin = 50; // 右边缘锥桶离赛道左边缘最小距离
@@ -472,7 +477,7 @@ private:
      * @param pointsCone
      * @return POINT
      */
-    POINT searchRightDownCone(vector<POINT> pointsCone)
+    POINT searchRightDownCone(const vector<POINT> &pointsCone)
     {
         POINT point(0, 0);
 
@@ -497,7 +502,7 @@ private:
      * @param pointsCone
      * @return vector<POINT>
      */
-    vector<POINT> searchLeftCone(vector<POINT> pointsCone)
+    vector<POINT> searchLeftCone(const vector<POINT> &pointsCone)
     {
         vector<POINT> points;
 
@@ -521,7 +526,7 @@ private:
      * @param pointsCone
      * @return vector<POINT>
      */
-    POINT searchRightUpCone(vector<POINT> pointsCone)
+    POINT searchRightUpCone(const vector<POINT> &pointsCone)
     {
         POINT point(0, 0);
 
@@ -545,7 +550,7 @@ private:
      * @param pointsCone
      * @return vector<POINT>
      */
-    vector<POINT> searchLeftDownCone(vector<POINT> pointsCone)
+    vector<POINT> searchLeftDownCone(const vector<POINT> &pointsCone)
     {
         vector<POINT> points;
 
@@ -569,7 +574,7 @@ private:
      * @param pointsEdgeLeft
      * @return vector<POINT>
      */
-    vector<POINT> predictEdgeRight(vector<POINT> pointsEdgeLeft)
+    vector<POINT> predictEdgeRight(const vector<POINT> &pointsEdgeLeft)
     {
         int offset = 180; // 右边缘平移尺度
         vector<POINT> pointsEdgeRight;
@@ -27,7 +27,7 @@
 #include <opencv2/highgui.hpp>
 #include <opencv2/opencv.hpp>
 #include "../../include/common.hpp"
-#include "../../include/predictor.hpp"
+#include "../../include/frame_context.hpp"
 #include "../recognition/track_recognition.cpp"
 
 using namespace cv;
@@ -48,19 +48,22 @@ public:
         slowZoneEnable = false; // 慢行区使能标志
     }
 
-    bool slowZoneDetection(TrackRecognition &track, vector<PredictResult> predict)
+    /**
+     * @brief 非空闲：慢行区使能或标志计数中
+     *
+     */
+    bool busy(void)
+    {
+        return slowZoneEnable || counterRec > 0;
+    }
+
+    bool slowZoneDetection(TrackRecognition &track, const FrameContext &frame)
     {
         // 检测标志
-        for (int i = 0; i < predict.size(); i++)
-        {
-            if (predict[i].label == LABEL_BUMP || predict[i].label == LABEL_PIG)
-            {
-                counterRec++;
-                break;
-            }
-        }
+        if (frame.predictsFresh && (frame.predicts.has(LABEL_BUMP) || frame.predicts.has(LABEL_PIG))) // 同一推理结果只计一次
+            counterRec++;
 
-        if (counterRec)
+        if (counterRec && frame.predictsFresh) // 场次按推理结果计
         {
             counterSession++;
             if (counterRec >= 4 && counterSession < 8)
@@ -106,7 +109,7 @@ public:
      * @brief 识别结果图像绘制
      *
      */
-    void drawImage(TrackRecognition track, Mat &image)
+    void drawImage(const TrackRecognition &track, Mat &image)
     {
         // 赛道边缘
         for (int i = 0; i < track.pointsEdgeLeft.size(); i++)
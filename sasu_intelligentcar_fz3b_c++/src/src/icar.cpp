@@ -8,22 +8,13 @@
  * @copyright Copyright (c) 2023
  *
  */
-#include "../include/common.hpp"            //公共类方法文件
-#include "../include/detection.hpp"         //百度Paddle框架移动端部署
-#include "../include/uart.hpp"              //串口通信驱动
-#include "controlcenter_cal.cpp"            //控制中心计算类
-#include "detection/bridge_detection.cpp"   //桥梁AI检测与路径规划类
-#include "detection/depot_detection.cpp"    //维修厂AI检测
-#include "detection/farmland_detection.cpp" //农田区域AI检测
-#include "detection/granary_detection.cpp"  //粮仓AI检测
-#include "detection/slowzone_detection.cpp" //慢行区AI检测与路径规划类
-#include "image_preprocess.cpp"             //图像预处理类
-#include "motion_controller.cpp"            //智能车运动控制类
-#include "recognition/cross_recognition.cpp" //十字道路识别与路径规划类
-#include "recognition/freezone_recognition.cpp" //泛行区识别类
-#include "recognition/garage_recognition.cpp"   //车库及斑马线识别类
-#include "recognition/ring_recognition.cpp" //环岛道路识别与路径规划类
-#include "recognition/track_recognition.cpp" //赛道识别基础类
+#include "../include/common.hpp"    //公共类方法文件
+#include "../include/detection.hpp" //百度Paddle框架移动端部署
+#include "../include/profiler.hpp"  //分阶段耗时统计
+#include "../include/run_log.hpp"   //运行日志（单文件逐帧记录）
+#include "../include/stage_executor.hpp" //多级流水线执行器
+#include "../include/uart.hpp"      //串口通信驱动
+#include "icar_pipeline.cpp"        //单帧处理流程（识别与控制）
 #include <chrono>
 #include <iostream>
 #include <mutex>
@@ -35,135 +26,70 @@
 using namespace std;
 using namespace cv;
 
+/**
+ * @brief 流水线帧槽位：预处理级 -> 识别控制级
+ *
+ */
+struct PipelineFrame {
+  std::shared_ptr<DetectionResult> resultAI; // AI预测数据（下一次取帧后失效）
+  Mat frameBgr;                              // YUYV帧转换结果（RGB流程）
+  Mat imageBinary;                           // 预处理输出
+  vector<PredictResult> predicts;            // AI检测结果（识别级可改写）
+  bool predictsFresh = false;                // 新的推理结果（false：沿用上次推理的结果）
+  uint64_t frameId = 0;                      // 图像帧序号
+  Mat frameLog;                              // 运行日志原始帧（拷贝）
+  vector<PredictResult> predictsLog;         // 运行日志AI检测结果（元素识别前）
+};
+
 void callbackSignal(int signum);
+void systemExit(int code);
+void callbackProfile(int signum);
 void displayWindowInit(void);
-void slowDownEnable(void);
+void pipelineRun(std::shared_ptr<Detection> detection, IcarPipeline &pipeline);
+bool predictsFresh(std::shared_ptr<DetectionResult> &resultAI,
+                   vector<PredictResult> &predicts);
+void runLogWrite(uint64_t frameId, double time, Mat &frame, bool frameOwned,
+                 vector<PredictResult> &predicts, bool predictsFresh,
+                 IcarPipeline &pipeline);
 std::shared_ptr<Driver> driver = nullptr; // 初始化串口驱动
-bool slowDown = false;                    // 特殊区域减速标志
-uint16_t counterSlowDown = 0;             // 减速计数器
-
-bool allowRingState = true;               // 初始设定允许"圆环状态"
-bool allowStart = false;
-
-void Timer() {
-  // 由于第二圈肯定没有圆环所以第一次5秒后禁止圆环后35秒后才解放(除非学弟学妹们车能上2m)
-  std::this_thread::sleep_for(std::chrono::seconds(35));
-  allowRingState = true; // 20秒后允许"圆环状态"
-
-  std::this_thread::sleep_for(std::chrono::seconds(15));
-  allowRingState = false;
-}
+RunLogQueue runLog;                       // 运行日志（后台写入）
+StagedExecutor<PipelineFrame> *executor = nullptr; // 分级流水线（退出时输出统计）
+bool traceEnable = false;                          // 退出时导出线程时间线
+volatile sig_atomic_t exitSignal = 0;              // 退出信号（信号处理函数只置位）
 
-void Timer1() {
-  std::this_thread::sleep_for(std::chrono::seconds(5));
-  allowRingState = false; // 5秒后取消"圆环状态"
-}
-
-void Timer2() {
-  std::this_thread::sleep_for(std::chrono::seconds(70));
-  allowStart = true;
+/**
+ * @brief 系统时间（ms）：驱动单帧处理流程的计时器
+ *
+ */
+double timeNowMs(void) {
+  return chrono::duration<double, milli>(
+             chrono::steady_clock::now().time_since_epoch())
+      .count();
 }
 
-// 图像高光选取
-cv::Mat HighLight(cv::Mat input, int light) {
-  // 生成灰度图
-  cv::Mat gray = cv::Mat::zeros(input.size(), CV_32FC1);
-  cv::Mat f = input.clone();
-  f.convertTo(f, CV_32FC3);
-  vector<cv::Mat> pics;
-  split(f, pics);
-  gray = 0.299f * pics[2] + 0.587 * pics[1] + 0.114 * pics[0];
-  gray = gray / 255.f;
-
-  // 确定高光区
-  cv::Mat thresh = cv::Mat::zeros(gray.size(), gray.type());
-  thresh = gray.mul(gray);
-  // 取平均值作为阈值
-  Scalar t = mean(thresh);
-  cv::Mat mask = cv::Mat::zeros(gray.size(), CV_8UC1);
-  mask.setTo(255, thresh >= t[0]);
-
-  // 参数设置
-  int max = 4;
-  float bright = light / 100.0f / max;
-  float mid = 1.0f + max * bright;
-
-  // 边缘平滑过渡
-  cv::Mat midrate = cv::Mat::zeros(input.size(), CV_32FC1);
-  cv::Mat brightrate = cv::Mat::zeros(input.size(), CV_32FC1);
-  for (int i = 0; i < input.rows; ++i) {
-    uchar *m = mask.ptr<uchar>(i);
-    float *th = thresh.ptr<float>(i);
-    float *mi = midrate.ptr<float>(i);
-    float *br = brightrate.ptr<float>(i);
-    for (int j = 0; j < input.cols; ++j) {
-      if (m[j] == 255) {
-        mi[j] = mid;
-        br[j] = bright;
-      } else {
-        mi[j] = (mid - 1.0f) / t[0] * th[j] + 1.0f;
-        br[j] = (1.0f / t[0] * th[j]) * bright;
-      }
-    }
-  }
-
-  // 高光提亮，获取结果图
-  cv::Mat result = cv::Mat::zeros(input.size(), input.type());
-  for (int i = 0; i < input.rows; ++i) {
-    float *mi = midrate.ptr<float>(i);
-    float *br = brightrate.ptr<float>(i);
-    uchar *in = input.ptr<uchar>(i);
-    uchar *r = result.ptr<uchar>(i);
-    for (int j = 0; j < input.cols; ++j) {
-      for (int k = 0; k < 3; ++k) {
-        float temp = pow(float(in[3 * j + k]) / 255.f, 1.0f / mi[j]) *
-                     (1.0 / (1 - br[j]));
-        if (temp > 1.0f)
-          temp = 1.0f;
-        if (temp < 0.0f)
-          temp = 0.0f;
-        uchar utemp = uchar(255 * temp);
-        r[3 * j + k] = utemp;
-      }
-    }
-  }
-  return result;
+/**
+ * @brief 取本帧的AI检测结果，并判断是否为新的推理结果
+ *
+ * @param predicts 输出：最近一次推理的结果（锥桶等检测框每帧可用于路径规划）
+ * @return true 新的推理结果（det_frame_id变化）
+ * @note 采集线程为每帧附带最新的推理结果，推理慢于采集时连续多帧携带同一结果（det_age > 0），
+ *       元素识别的标志防抖计数（counterRec/counterSession）只在新结果时累计
+ */
+bool predictsFresh(std::shared_ptr<DetectionResult> &resultAI,
+                   vector<PredictResult> &predicts) {
+  static uint64_t detFrameLast = 0; // 上次交给识别的推理结果帧序号
+  predicts = resultAI->predictor_results;
+  if (resultAI->det_frame_id == 0 || resultAI->det_frame_id == detFrameLast)
+    return false;
+  detFrameLast = resultAI->det_frame_id;
+  return true;
 }
 
-enum RoadType {
-  BaseHandle = 0, // 基础赛道处理
-  RingHandle,     // 环岛赛道处理
-  CrossHandle,    // 十字道路处理
-  FreezoneHandle, // 泛行区处理
-  GarageHandle,   // 车库处理
-  GranaryHandle,  // 粮仓处理
-  DepotHandle,    // 修车厂处理
-  BridgeHandle,   // 坡道(桥)处理
-  SlowzoneHandle, // 慢行区（动物出没）处理
-  FarmlandHandle, // 农田区域处理
-};
-
 int main(int argc, char const *argv[]) {
   std::shared_ptr<Detection> detection = nullptr; // 初始化AI预测模型
-  ImagePreprocess imagePreprocess;                // 图像预处理类
-  TrackRecognition trackRecognition;              // 赛道识别
-  ControlCenterCal controlCenterCal;              // 控制中心计算
-  MotionController motionController;              // 运动控制
-  RingRecognition ringRecognition;                // 环岛识别
-  CrossroadRecognition crossroadRecognition;      // 十字道路处理
-  GarageRecognition garageRecognition;            // 车库识别
-  FreezoneRecognition freezoneRecognition;        // 泛型区识别类
-  FarmlandDetection farmlandDetection;            // 农田区域检测
-  DepotDetection depotDetection;                  // 维修厂检测
-  GranaryDetection granaryDetection;              // 粮仓检测
-  BridgeDetection bridgeDetection;                // 桥梁检测
-  SlowZoneDetection slowZoneDetection;            // 慢行区检测
-  uint16_t counterRunBegin = 1; // 智能车启动计数器：等待摄像头图像帧稳定
-  RoadType roadType = RoadType::BaseHandle; // 初始化赛道类型
-  uint16_t counterOutTrackA = 0;            // 车辆冲出赛道计数器A
-  uint16_t counterOutTrackB = 0;            // 车辆冲出赛道计数器B
-  uint16_t circlesThis = 2;                 // 智能车当前运行的圈数
-  uint16_t countercircles = 0;              // 圈数计数器
+  IcarPipeline pipeline;                          // 单帧处理流程
+  TrackRecognition &trackRecognition = pipeline.trackRecognition; // 赛道识别
+  MotionController &motionController = pipeline.motionController; // 运动控制
 
   // USB转串口的设备名为 / dev/ttyUSB0
   driver = std::make_shared<Driver>("/dev/ttyUSB0", BaudRate::BAUD_115200);
@@ -178,20 +104,20 @@ int main(int argc, char const *argv[]) {
     return -1;
   }
 
-  ipm.init(Size(COLSIMAGE, ROWSIMAGE),
-           Size(COLSIMAGEIPM, ROWSIMAGEIPM)); // IPM逆透视变换初始化
-
-  signal(SIGINT, callbackSignal);             // 程序退出信号
-
-  motionController.loadParams();              // 读取配置文件
-  trackRecognition.rowCutUp = motionController.params.rowCutUp;
-  trackRecognition.rowCutBottom = motionController.params.rowCutBottom;
-  garageRecognition.disGarageEntry = motionController.params.disGarageEntry;
-
-  if (motionController.params.GarageEnable) // 出入库使能
-    roadType = RoadType::GarageHandle;      // 初始赛道元素为出库
-
-  imagePreprocess.imageCorrecteInit();      // 图像矫正参数初始化
+  signal(SIGINT, callbackSignal);   // 程序退出信号
+  signal(SIGUSR1, callbackProfile); // 分阶段耗时统计输出
+
+  motionController.loadParams(); // 读取配置文件
+  Profiler::enable(motionController.params.profileEnable);
+  Profiler::enableCounters(motionController.params.profileCounters);
+  traceEnable = motionController.params.profileTrace;
+  pthread_setname_np(pthread_self(), "control"); // 控制循环（分级流水线时仅等待）
+  pipeline.init();               // IPM/识别参数/图像矫正初始化
+  Recorder::instance().init(motionController.params.recordSlots,
+                            motionController.params.recordBlock); // 异步存图参数：写线程在首次存图时启动
+  bool imageRgbEnable = motionController.params.debug ||
+                        motionController.params.saveImage; // RGB预处理使能
+  double timeStart = -1;                                   // 比赛开始时间
 
   if (motionController.params.debug) {
     displayWindowInit(); // 显示窗口初始化 //显示窗口初始化
@@ -201,17 +127,22 @@ int main(int argc, char const *argv[]) {
     printAiEnable = true;              // AI检测结果绘制
   } else {
     cout << "等待发车!!!" << endl;
+    CaptureParams captureParams; // 摄像头采集参数
+    captureParams.v4l2 = motionController.params.v4l2Enable;
+    captureParams.mjpeg = motionController.params.v4l2Mjpeg;
+    captureParams.buffers = motionController.params.v4l2Buffers;
     detection = Detection::DetectionInstance(
-        "/dev/video0", "../res/model/mobilenet-ssd"); // Video输入源
+        "/dev/video0", "../res/model/mobilenet-ssd", captureParams); // Video输入源
     printAiEnable = false;                            // AI检测结果绘制
 
     while (!driver->receiveStartSignal()) // 串口接收下位机-比赛开始信号
     {
-      ;
+      if (exitSignal)
+        systemExit(exitSignal);
     }
     cout << "--------- System start!!! -------" << endl;
-    std::thread timer11(Timer2); // 创建一个新线程来倒计时
-    timer11.detach();
+    timeStart = timeNowMs();
+    pipeline.start(timeStart); // 入库倒计时
 
     for (int i = 0; i < 30; i++)          // 3秒后发车
     {
@@ -220,10 +151,20 @@ int main(int argc, char const *argv[]) {
     }
   }
 
-  while (1) {
+  if (motionController.params.runLogEnable) {
+    string pathLog =
+        "../res/samples/run_" + to_string(time(nullptr)) + ".runlog";
+    if (runLog.open(pathLog, timeStart, motionController.params.runLogJpeg))
+      cout << "Run log: " << pathLog << endl;
+    else
+      cout << "Error: run log open failed: " << pathLog << endl;
+  }
 
-    bool imshowRec = false; // 特殊赛道图像显示标志
+  if (motionController.params.pipelineEnable &&
+      !motionController.params.debug) // 分级流水线：不返回
+    pipelineRun(detection, pipeline);
 
+  while (!exitSignal) {
     // 处理帧时长监测把debug注释了可以查看处理每一帧画面的速度
     if (motionController.params.debug) {
       static auto preTime = chrono::duration_cast<chrono::milliseconds>(
@@ -233,13 +174,35 @@ int main(int argc, char const *argv[]) {
                            chrono::system_clock::now().time_since_epoch())
                            .count();
       cout << "run frame time : " << startTime - preTime << "ms" << endl;
+      if (trackRecognition.trackingEnable) // 帧间跟踪命中统计
+        cout << "track tracking : " << trackRecognition.trackingHits << "/"
+             << trackRecognition.trackingHits + trackRecognition.trackingMisses
+             << " rows, " << trackRecognition.trackingFrames << "/"
+             << trackRecognition.trackingFrames +
+                    trackRecognition.trackingFullFrames
+             << " frames" << endl;
       preTime = startTime;
+      static uint32_t counterFrames = 0;
+      if (++counterFrames % 100 == 0) { // 帧传递统计：覆盖丢弃/重复读取
+        detection->printFrameStatistics();
+        pipeline.printElementTiming(); // 赛道元素处理耗时
+        Recorder::instance().printStatistics(); // 存图写入/丢弃统计
+      }
     }
 
     //[01] 视频源选择
-    std::shared_ptr<DetectionResult> resultAI =
-        detection->getLastFrame();   // 获取Paddle多线程模型预测数据
+    std::shared_ptr<DetectionResult> resultAI;
+    {
+      PROFILE_SCOPE("wait_frame"); // 等待采集线程的新帧
+      resultAI = detection->getLastFrame(
+          motionController.params.frameWait); // 获取Paddle多线程模型预测数据
+    }
     Mat frame = resultAI->rgb_frame; // 获取原始摄像头图像
+    if (imageRgbEnable && frame.channels() == 2) { // V4L2 YUYV帧：RGB流程需转换
+      static Mat frameBgr;
+      Capture::toBgr(resultAI->rgb_frame, frameBgr);
+      frame = frameBgr;
+    }
     if (motionController.params.debug) {
       savePicture(resultAI->det_render_frame);
     } else {
@@ -247,439 +210,32 @@ int main(int argc, char const *argv[]) {
         savePicture(frame);
     }
 
-    //[02] 图像预处理
-    Mat imgaeCorrect = imagePreprocess.imageCorrection(frame); // RGB
-    int light1 = -50;
-    Mat src = HighLight(imgaeCorrect, light1);
-    Mat imageBinary = imagePreprocess.imageBinaryzation(src); // Gray
-
-    //[03] 基础赛道识别
-    trackRecognition.trackRecognition(
-        imageBinary); // 赛道线识别   可以尝试修改成八领域巡线
-    if (motionController.params.debug) {
-      Mat imageTrack = imgaeCorrect.clone(); // RGB
-      trackRecognition.drawImage(imageTrack); // 图像显示赛道线识别结果
-      imshow("imageTrack", imageTrack);
-      savePicture(imageTrack);
-    }
-
-    // [04] 出库和入库识别与路径规划
-    if (motionController.params.GarageEnable) // 赛道元素是否使能
-    {
-      if (roadType == RoadType::GarageHandle ||
-          roadType == RoadType::BaseHandle) {
-        countercircles++; // 圈数计数
-        if (countercircles > 200)
-          countercircles = 200;
-        if (garageRecognition.startingCheck(
-                resultAI->predictor_results))   // 检测到起点
-        {
-          if (roadType == RoadType::BaseHandle) // 初次识别-蜂鸣器提醒
-            driver->buzzerSound(1);
-
-          bridgeDetection.reset();
-          depotDetection.reset();
-          farmlandDetection.reset();
-          granaryDetection.reset();
-          slowZoneDetection.reset();
-          crossroadRecognition.reset();
-          freezoneRecognition.reset(); // 泛行区识别复位
-          ringRecognition.reset();     // 环岛识别初始化
-
-          if (countercircles > 60) {
-            circlesThis++;
-            countercircles = 0;
-          }
-        }
-
-        if (circlesThis >= motionController.params.circles &&
-            countercircles > 100 && allowStart) // 入库使能：跑完N圈
-          garageRecognition.entryEnable = true;
-
-        if (garageRecognition.garageRecognition(trackRecognition,
-                                                resultAI->predictor_results)) {
-          if (roadType == RoadType::BaseHandle) // 初次识别-蜂鸣器提醒
-            driver->buzzerSound(1);             // OK
-
-          roadType = RoadType::GarageHandle;
-          if (garageRecognition.garageStep ==
-              garageRecognition.GarageEntryFinish) // 入库完成
-          {
-            cout << ">>>>>>>   入库结束 !!!!!" << endl;
-            callbackSignal(0);
-          }
-          if (motionController.params.debug) {
-            Mat imageGarage =
-                Mat::zeros(Size(COLSIMAGE, ROWSIMAGE), CV_8UC3); // 初始化图像
-            garageRecognition.drawImage(trackRecognition, imageGarage);
-            imshow("imageRecognition", imageGarage);
-            imshowRec = true;
-            savePicture(imageGarage);
-          }
-        } else
-          roadType = RoadType::BaseHandle;
-
-        if (garageRecognition.slowDown) // 入库减速
-          slowDownEnable();
-      }
-    }
-
-    //[05] 农田区域检测
-    if (motionController.params.FarmlandEnable) // 赛道元素是否使能
+    //[02] 识别与控制
+    double time = timeNowMs();
+    static vector<PredictResult> predicts, predictsLog;
+    bool fresh = predictsFresh(resultAI, predicts);
+    if (runLog.isOpen()) // 元素识别可能改写检测结果：记录识别前的输入
+      predictsLog = predicts;
     {
-      if (roadType == RoadType::FarmlandHandle ||
-          roadType == RoadType::BaseHandle) {
-        if (farmlandDetection.farmlandDetection(trackRecognition,
-                                                resultAI->predictor_results)) {
-          if (roadType == RoadType::BaseHandle) // 初次识别-蜂鸣器提醒
-            driver->buzzerSound(1);             // OK
-
-          roadType = RoadType::FarmlandHandle;
-          if (motionController.params.debug) {
-            Mat imageFarmland =
-                Mat::zeros(Size(COLSIMAGE, ROWSIMAGE), CV_8UC3); // 初始化图像
-            farmlandDetection.drawImage(trackRecognition, imageFarmland);
-            imshow("imageRecognition", imageFarmland);
-            imshowRec = true;
-            savePicture(imageFarmland);
-          }
-        } else
-          roadType = RoadType::BaseHandle;
-      }
-    }
-
-    //[06] 维修厂检测
-    if (motionController.params.DepotEnable) // 赛道元素是否使能
-    {
-      if (roadType == RoadType::DepotHandle ||
-          roadType == RoadType::BaseHandle) {
-        if (depotDetection.depotDetection(trackRecognition,
-                                          resultAI->predictor_results)) {
-          if (roadType == RoadType::BaseHandle) // 初次识别-蜂鸣器提醒
-            driver->buzzerSound(1);             // OK
-
-          roadType = RoadType::DepotHandle;
-          if (motionController.params.debug) {
-            Mat imageDepot =
-                Mat::zeros(Size(COLSIMAGE, ROWSIMAGE), CV_8UC3); // 初始化图像
-            depotDetection.drawImage(trackRecognition, imageDepot);
-            imshow("imageRecognition", imageDepot);
-            imshowRec = true;
-            savePicture(imageDepot);
-          }
-        } else
-          roadType = RoadType::BaseHandle;
-      }
-    }
-
-    //[07] 粮仓检测
-    if (motionController.params.GranaryEnable) // 赛道元素是否使能
-    {
-      if (roadType == RoadType::GranaryHandle ||
-          roadType == RoadType::BaseHandle) {
-        if (granaryDetection.granaryDetection(trackRecognition,
-                                              resultAI->predictor_results)) {
-          if (roadType == RoadType::BaseHandle) // 初次识别-蜂鸣器提醒
-            driver->buzzerSound(1);             // OK
-
-          roadType = RoadType::GranaryHandle;
-          if (motionController.params.debug) {
-            Mat imageGranary =
-                Mat::zeros(Size(COLSIMAGE, ROWSIMAGE), CV_8UC3); // 初始化图像
-            granaryDetection.drawImage(trackRecognition, imageGranary);
-            imshow("imageRecognition", imageGranary);
-            imshowRec = true;
-            savePicture(imageGranary);
-          }
-        } else
-          roadType = RoadType::BaseHandle;
-      }
-    }
-
-    // [08] 坡道（桥）检测与路径规划
-    if (motionController.params.BridgeEnable) // 赛道元素是否使能
-    {
-      if (roadType == RoadType::BridgeHandle ||
-          roadType == RoadType::BaseHandle) {
-        if (bridgeDetection.bridgeDetection(trackRecognition,
-                                            resultAI->predictor_results)) {
-          if (roadType == RoadType::BaseHandle) // 初次识别-蜂鸣器提醒
-            driver->buzzerSound(1);             // OK
-
-          roadType = RoadType::BridgeHandle;
-          if (motionController.params.debug) {
-            Mat imageBridge =
-                Mat::zeros(Size(COLSIMAGE, ROWSIMAGE), CV_8UC3); // 初始化图像
-            bridgeDetection.drawImage(trackRecognition, imageBridge);
-            imshow("imageRecognition", imageBridge);
-            imshowRec = true;
-            savePicture(imageBridge);
-          }
-        } else
-          roadType = RoadType::BaseHandle;
-      }
-    }
-
-    // [09] 慢行区检测与路径规划
-    if (motionController.params.SlowzoneEnable) // 赛道元素是否使能
-    {
-      if (roadType == RoadType::SlowzoneHandle ||
-          roadType == RoadType::BaseHandle) {
-        if (slowZoneDetection.slowZoneDetection(trackRecognition,
-                                                resultAI->predictor_results)) {
-          if (roadType == RoadType::BaseHandle) // 初次识别-蜂鸣器提醒
-            driver->buzzerSound(1);             // OK
-
-          roadType = RoadType::SlowzoneHandle;
-          if (motionController.params.debug) {
-            Mat imageSlow =
-                Mat::zeros(Size(COLSIMAGE, ROWSIMAGE), CV_8UC3); // 初始化图像
-            slowZoneDetection.drawImage(trackRecognition, imageSlow);
-            imshow("imageRecognition", imageSlow);
-            imshowRec = true;
-            savePicture(imageSlow);
-          }
-        } else
-          roadType = RoadType::BaseHandle;
-      }
-    }
-
-    // [10] 泛行区检测与识别（无泛行区）
-    if (motionController.params.FreezoneEnable) // 赛道元素是否使能
-    {
-      if (roadType == RoadType::FreezoneHandle ||
-          roadType == RoadType::BaseHandle) {
-        if (freezoneRecognition.freezoneRecognition(trackRecognition)) {
-          if (roadType == RoadType::BaseHandle) // 初次识别-蜂鸣器提醒
-            driver->buzzerSound(1);             // OK
-
-          roadType = RoadType::FreezoneHandle;
-          if (motionController.params.debug) {
-            Mat imageFreezone =
-                Mat::zeros(Size(COLSIMAGE, ROWSIMAGE), CV_8UC3); // 初始化图像
-            freezoneRecognition.drawImage(trackRecognition, imageFreezone);
-            imshow("imageRecognition", imageFreezone);
-            imshowRec = true;
-            savePicture(imageFreezone);
-          }
-        } else
-          roadType = RoadType::BaseHandle;
-      }
-    }
-
-    if (motionController.params.RingEnable) // 赛道元素是否使能
-    {
-      if (allowRingState) {
-        if (roadType == RoadType::RingHandle ||
-            roadType == RoadType::BaseHandle) {
-          if (motionController.params.ringDirection ==
-              0) { // 左右圆环准备分开的暂时去除了右圆环
-            if (ringRecognition.ringRecognition(trackRecognition,
-                                                imageBinary)) {
-              if (roadType == RoadType::BaseHandle) {
-                driver->buzzerSound(1);
-                std::thread timer6(Timer1); // 创建一个新线程来倒计时
-                timer6.detach();
-                std::thread timer7(Timer);  // 创建一个新线程来倒计时
-                timer7.detach();
-              }
-              roadType = RoadType::RingHandle;
-            } else {
-              roadType = RoadType::BaseHandle;
-            }
-          }
-        }
-      }
-    }
-
-    // [12] 十字道路处理
-    if (motionController.params.CrossEnable) // 赛道元素是否使能
-    {
-      if (roadType == RoadType::CrossHandle ||
-          roadType == RoadType::BaseHandle) {
-        if (crossroadRecognition.crossroadRecognition(
-                trackRecognition, resultAI->predictor_results)) {
-          roadType = RoadType::CrossHandle;
-        } else
-          roadType = RoadType::BaseHandle;
-      }
-      // }
-    }
-
-    // [13] 控制中心计算
-    if (trackRecognition.pointsEdgeLeft.size() < 30 &&
-        trackRecognition.pointsEdgeRight.size() < 30 &&
-        roadType != RoadType::BridgeHandle &&
-        roadType != RoadType::GranaryHandle &&
-        roadType != RoadType::DepotHandle &&
-        roadType != RoadType::FarmlandHandle) // 防止车辆冲出赛道
-    {
-      counterOutTrackA++;
-      counterOutTrackB = 0;
-      if (counterOutTrackA > 20)
-        callbackSignal(0);
-    } else {
-      counterOutTrackB++;
-      if (counterOutTrackB > 50) {
-        counterOutTrackA = 0;
-        counterOutTrackB = 50;
-      }
-    }
-
-    controlCenterCal.controlCenterCal(
-        trackRecognition); // 根据赛道边缘信息拟合运动控制中心
-
-    // [14] 运动控制
-    if (counterRunBegin > 30) ////智能车启动延时：前几场图像不稳定
-    {
-      // 智能汽车方向控制
-      if (roadType != RoadType::RingHandle)
-        motionController.pdController(
-            controlCenterCal.controlCenter); // PD控制器姿态控制圆环pid单独控制
-      else if (roadType == RoadType::RingHandle) {
-        if (motionController.params.ringDirection == 0)
-          motionController.RingpdController(controlCenterCal.controlCenter);
-        else if (motionController.params.ringDirection == 1)
-          motionController.RightRingpdController(
-              controlCenterCal.controlCenter);
-      }
-      // 智能汽车速度控制
-      switch (roadType) {
-      case RoadType::GarageHandle:
-        motionController.motorSpeed =
-            motionController.params.speedGarage; // 匀速控制
-        break;
-      case RoadType::BridgeHandle:
-        motionController.motorSpeed =
-            motionController.params.speedBridge; // 匀速控制
-        break;
-      case RoadType::SlowzoneHandle:
-        motionController.motorSpeed =
-            motionController.params.speedSlowzone; // 匀速控制
-        break;
-      case RoadType::RingHandle:
-        motionController.motorSpeed = motionController.params.speedRing;
-        break;
-      case RoadType::CrossHandle:
-        motionController.motorSpeed = motionController.params.speedcross;
-        break;
-      default:                                              // 基础巡线
-        motionController.speedController(true, slowDown,
-                                         controlCenterCal); // 变加速控制
-        break;
-      }
-
-      if (!motionController.params.debug) // 调试模式下不控制车辆运动
-      {
-        if (roadType == RoadType::DepotHandle) {
-          if (depotDetection.depotStep == 4)
-            driver->carControl(
-                0, motionController.servoPwm); // 串口通信，姿态与速度控制
-          else if (depotDetection.depotStep == 5)
-            driver->carControl(
-                -motionController.motorSpeed,
-                motionController.servoPwm); // 串口通信，姿态与速度控制
-          else
-            driver->carControl(
-                motionController.motorSpeed,
-                motionController.servoPwm); // 串口通信，姿态与速度控制
-        } else
-          driver->carControl(
-              motionController.motorSpeed,
-              motionController.servoPwm); // 串口通信，姿态与速度控制
-      }
-
-      // 减速缓冲
-      if (slowDown) {
-        counterSlowDown++;
-        if (counterSlowDown > 50) {
-          slowDown = false;
-          counterSlowDown = 0;
-        }
-      }
-    } else
-      counterRunBegin++;
-
-    // [15]调试模式下图像显示和存图
-    if (motionController.params.debug) {
-      controlCenterCal.drawImage(trackRecognition, imgaeCorrect);
-      switch (roadType) {
-      case RoadType::BaseHandle: // 基础赛道处理 // 基础赛道处理
-        putText(imgaeCorrect, "[1] Track", Point(10, 20),
-                cv::FONT_HERSHEY_TRIPLEX, 0.3, cv::Scalar(0, 0, 255), 1,
-                CV_AA);          // 显示赛道识别类型
-        break;
-      case RoadType::RingHandle: // 环岛赛道处理 // 环岛赛道处理
-        putText(imgaeCorrect, "[2] Ring", Point(10, 20),
-                cv::FONT_HERSHEY_TRIPLEX, 0.3, cv::Scalar(0, 255, 0), 1,
-                CV_AA);           // 显示赛道识别类型
-        break;
-      case RoadType::CrossHandle: // 十字道路处理 // 十字道路处理
-        putText(imgaeCorrect, "[3] Cross", Point(10, 20),
-                cv::FONT_HERSHEY_TRIPLEX, 0.3, cv::Scalar(0, 255, 0), 1,
-                CV_AA);              // 显示赛道识别类型
-        break;
-      case RoadType::FreezoneHandle: // 泛行区处理 // 泛行区处理
-        putText(imgaeCorrect, "[4] Freezone", Point(10, 20),
-                cv::FONT_HERSHEY_TRIPLEX, 0.3, cv::Scalar(0, 255, 0), 1,
-                CV_AA);            // 显示赛道识别类型
-        break;
-      case RoadType::GarageHandle: // 车库处理 // 车库处理
-        putText(imgaeCorrect, "[5] Garage", Point(10, 20),
-                cv::FONT_HERSHEY_TRIPLEX, 0.3, cv::Scalar(0, 255, 0), 1,
-                CV_AA);             // 显示赛道识别类型
-        break;
-      case RoadType::GranaryHandle: // 粮仓处理 // 加油站处理
-        putText(imgaeCorrect, "[6] Granary", Point(10, 20),
-                cv::FONT_HERSHEY_TRIPLEX, 0.3, cv::Scalar(0, 255, 0), 1,
-                CV_AA);           // 显示赛道识别类型
-        break;
-      case RoadType::DepotHandle: // 修车厂处理 // 施工区处理
-        putText(imgaeCorrect, "[7] Depot", Point(10, 20),
-                cv::FONT_HERSHEY_TRIPLEX, 0.3, cv::Scalar(0, 255, 0), 1,
-                CV_AA);            // 显示赛道识别类型
-        break;
-      case RoadType::BridgeHandle: // 坡道(桥)处理 // 坡道处理
-        putText(imgaeCorrect, "[8] Bridge", Point(10, 20),
-                cv::FONT_HERSHEY_TRIPLEX, 0.3, cv::Scalar(0, 255, 0), 1,
-                CV_AA);              // 显示赛道识别类型
-        break;
-      case RoadType::SlowzoneHandle: // 慢行区（动物出没）处理 // 坡道处理
-        putText(imgaeCorrect, "[9] Slowzone", Point(10, 20),
-                cv::FONT_HERSHEY_TRIPLEX, 0.3, cv::Scalar(0, 255, 0), 1,
-                CV_AA);              // 显示赛道识别类型
-        break;
-      case RoadType::FarmlandHandle: // 农田区域处理 // 坡道处理
-        putText(imgaeCorrect, "[10] Farmland", Point(10, 20),
-                cv::FONT_HERSHEY_TRIPLEX, 0.3, cv::Scalar(0, 255, 0), 1,
-                CV_AA); // 显示赛道识别类型
-        break;
-      }
-
-      putText(imgaeCorrect,
-              "v: " + formatDoble2String(motionController.motorSpeed, 2),
-              Point(COLSIMAGE - 60, 80), FONT_HERSHEY_PLAIN, 1,
-              Scalar(0, 0, 255), 1); // 车速
-
-      string str = to_string(circlesThis) + "/" +
-                   to_string(motionController.params.circles);
-      putText(imgaeCorrect, str, Point(COLSIMAGE - 50, ROWSIMAGE - 20),
-              cv::FONT_HERSHEY_TRIPLEX, 0.5, cv::Scalar(0, 255, 0), 1,
-              CV_AA); // 显示圈数
-      if (!imshowRec) // 保持调试图像存储顺序和显示一致性
-      {
-        Mat imageNone =
-            Mat::zeros(Size(COLSIMAGE, ROWSIMAGE), CV_8UC3); // 初始化图像
-        imshow("imageRecognition", imageNone);
-        savePicture(imageNone);
-      }
-      imshow("imageControl", imgaeCorrect);
-      savePicture(imgaeCorrect);
-
-      char c = waitKey(1);
+      PROFILE_SCOPE("frame");
+      pipeline.process(frame, predicts, time, fresh);
     }
+    if (runLog.isOpen())
+      runLogWrite(resultAI->frame_id, time, resultAI->rgb_frame, false,
+                  predictsLog, fresh, pipeline);
+    if (pipeline.buzzer) // 初次识别-蜂鸣器提醒
+      driver->buzzerSound(1);
+    if (pipeline.finish) // 入库完成/冲出赛道
+      systemExit(0);
+
+    //[03] 运动控制：调试模式下不控制车辆运动
+    if (pipeline.controlEnable && !motionController.params.debug)
+      driver->carControl(pipeline.controlSpeed,
+                         motionController.servoPwm); // 串口通信，姿态与速度控制
+    Profiler::instance().poll(); // SIGUSR1请求的统计输出
   }
 
+  systemExit(exitSignal); // SIGINT
   return 0;
 }
 
@@ -687,13 +243,155 @@ int main(int argc, char const *argv[]) {
  * @brief 系统信号回调函数：系统退出
  *
  * @param signum 信号量
+ * @note 只请求结束（异步信号安全）：控制循环在本帧结束后、分级流水线在各级线程退出后，
+ *       由主线程完成停车、统计输出与日志关闭；主线程无响应时再次Ctrl+C直接退出
  */
 void callbackSignal(int signum) {
+  if (exitSignal)
+    _exit(signum);
+  exitSignal = signum;
+  if (executor != nullptr)
+    executor->stop(); // 原子置位：首级不再取新帧
+}
+
+/**
+ * @brief 系统退出：停车、输出统计并关闭日志
+ *
+ * @param code 退出码
+ */
+void systemExit(int code) {
   driver->carControl(0, PWMSERVOMID); // 智能车停止运动
-  cout << "====System Exit!!!  -->  CarStopping! " << signum << endl;
-  exit(signum);
+  cout << "====System Exit!!!  -->  CarStopping! " << code << endl;
+  if (executor != nullptr)
+    executor->printStatistics(); // 流水线各级耗时与端到端延迟
+  if (Profiler::enabled())
+    Profiler::instance().report(); // 分阶段耗时
+  if (Profiler::enabled() && traceEnable) // 线程时间线
+    Profiler::instance().writeTrace("../res/samples/trace_" +
+                                    to_string(time(nullptr)) + ".json");
+  Recorder::instance().stop(); // 写完队列中剩余的图像
+  Recorder::instance().printStatistics();
+  if (runLog.isOpen()) {
+    runLog.close(); // 写完队列中剩余的帧
+    cout << "Run log frames: " << runLog.frames() << " bytes: " << runLog.bytes()
+         << " dropped: " << runLog.dropped() << endl;
+  }
+  exit(code);
 }
 
+/**
+ * @brief 运行日志：记录单帧输入（原始图像/识别前的AI检测结果）与识别控制输出
+ *
+ * @param frameOwned 原始帧为调用方的拷贝：与槽位缓存交换，不再拷贝（false：可能指向V4L2驱动缓存，拷入槽位）
+ * @note 只拷入预分配槽位，编码与写文件在后台线程；队满时丢弃本帧
+ */
+void runLogWrite(uint64_t frameId, double time, Mat &frame, bool frameOwned,
+                 vector<PredictResult> &predicts, bool predictsFresh,
+                 IcarPipeline &pipeline) {
+  RunLogFrame *record = runLog.acquire();
+  if (record == nullptr)
+    return;
+  record->frameId = frameId;
+  record->time = time;
+  if (frameOwned)
+    std::swap(record->image, frame);
+  else
+    frame.copyTo(record->image);
+  record->predicts.swap(predicts);
+  record->predictsFresh = predictsFresh;
+  record->edgeLeft = pipeline.trackRecognition.pointsEdgeLeft;
+  record->edgeRight = pipeline.trackRecognition.pointsEdgeRight;
+  record->roadType = pipeline.roadType;
+  record->controlCenter = pipeline.controlCenterCal.controlCenter;
+  record->servoPwm = pipeline.motionController.servoPwm;
+  record->motorSpeed = pipeline.motionController.motorSpeed;
+  record->controlSpeed = pipeline.controlEnable ? pipeline.controlSpeed : 0;
+  runLog.commit();
+}
+
+/**
+ * @brief 分级流水线运行（非调试模式）：采集与AI推理已在Detection内部线程，
+ *        此处将[02]预处理与[03]~[15]识别控制拆为两级，分别绑定CPU核，
+ *        识别控制第N帧时预处理第N+1帧；端到端延迟从采集时刻计到下发控制
+ *
+ */
+void pipelineRun(std::shared_ptr<Detection> detection, IcarPipeline &pipeline) {
+  MotionController &motionController = pipeline.motionController;
+  MotionController::Params &params = motionController.params;
+  bool imageRgbEnable = params.saveImage; // 非调试模式：仅存图需RGB流程
+  vector<int> cores = params.pipelineCores;
+  cores.resize(2, -1);
+
+  static StagedExecutor<PipelineFrame> staged;
+  using Slot = StagedExecutor<PipelineFrame>::Slot;
+
+  //[01]~[02] 取AI预测数据并预处理
+  staged.addStage(
+      "preprocess",
+      [&](Slot &slot) {
+        PipelineFrame &data = slot.data;
+        {
+          PROFILE_SCOPE("wait_frame");
+          data.resultAI = detection->getLastFrame(params.frameWait);
+        }
+        if (data.resultAI->stamp.time_since_epoch().count() > 0)
+          slot.origin = data.resultAI->stamp; // 端到端延迟从采集时刻计
+        Mat frame = data.resultAI->rgb_frame;
+        if (imageRgbEnable && frame.channels() == 2) {
+          Capture::toBgr(frame, data.frameBgr);
+          frame = data.frameBgr;
+        }
+        if (params.saveImage) // 保存原始图像
+          savePicture(frame);
+        data.frameId = data.resultAI->frame_id;
+        data.predictsFresh = predictsFresh(data.resultAI, data.predicts);
+        if (runLog.isOpen()) {
+          data.resultAI->rgb_frame.copyTo(data.frameLog);
+          data.predictsLog = data.predicts;
+        }
+        pipeline.preprocess(frame, data.imageBinary);
+        return true;
+      },
+      cores[0]);
+
+  //[03]~[15] 识别与控制
+  staged.addStage(
+      "control",
+      [&](Slot &slot) {
+        PipelineFrame &data = slot.data;
+        double time = timeNowMs();
+        pipeline.recognize(data.imageBinary, data.predicts, time,
+                           data.predictsFresh);
+        if (runLog.isOpen())
+          runLogWrite(data.frameId, time, data.frameLog, true,
+                      data.predictsLog, data.predictsFresh, pipeline);
+        if (pipeline.buzzer) // 初次识别-蜂鸣器提醒
+          driver->buzzerSound(1);
+        if (pipeline.finish) // 入库完成/冲出赛道
+          return false;
+        if (pipeline.controlEnable)
+          driver->carControl(pipeline.controlSpeed,
+                             motionController.servoPwm); // 串口通信，姿态与速度控制
+        Profiler::instance().poll();
+        return true;
+      },
+      cores[1]);
+
+  executor = &staged;
+  staged.start(params.pipelineDepth);
+  if (exitSignal) // start()前已收到SIGINT
+    staged.stop();
+  staged.wait(); // 入库完成/冲出赛道，或SIGINT请求结束
+  systemExit(exitSignal);
+}
+
+/**
+ * @brief 分阶段耗时统计输出请求（kill -USR1）：由控制循环在下一帧输出
+ *
+ * @param signum 信号量
+ */
+void callbackProfile(int signum) { Profiler::instance().requestReport(); }
+
 /**
  * @brief OpenCV图像显示窗口初始化（详细参数/Debug模式）
  *
@@ -717,12 +415,3 @@ void displayWindowInit(void) {
   cv::resizeWindow(windowName, 640, 480);     // 分辨率
   cv::moveWindow(windowName, 350, 20);        // 布局位置
 }
-
-/**
- * @brief 车辆减速使能
- *
- */
-void slowDownEnable(void) {
-  slowDown = true;
-  counterSlowDown = 0;
-}
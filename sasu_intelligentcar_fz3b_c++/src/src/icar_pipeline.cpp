@@ -0,0 +1,731 @@
+#pragma once
+/**
+ * @file icar_pipeline.cpp
+ * @author lse
+ * @brief 智能车单帧处理流程：预处理、赛道识别、元素识别、控制中心计算与运动控制
+ * @version 0.1
+ * @date 2023-07-20
+ * @note 与硬件无关：串口下发、蜂鸣器与程序退出由调用方根据输出标志执行，
+ *       计时器由调用方传入的时间驱动，icar实时运行与icar_replay离线回放共用
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include "../include/common.hpp"            //公共类方法文件
+#include "../include/element_handler.hpp"   //赛道元素处理表项
+#include "../include/frame_context.hpp"     //单帧共享数据
+#include "../include/profiler.hpp"          //分阶段耗时统计
+#include "../include/worker_pool.hpp"       //元素检测并行线程池
+#include "controlcenter_cal.cpp"            //控制中心计算类
+#include "detection/bridge_detection.cpp"   //桥梁AI检测与路径规划类
+#include "detection/depot_detection.cpp"    //维修厂AI检测
+#include "detection/farmland_detection.cpp" //农田区域AI检测
+#include "detection/granary_detection.cpp"  //粮仓AI检测
+#include "detection/slowzone_detection.cpp" //慢行区AI检测与路径规划类
+#include "image_preprocess.cpp"             //图像预处理类
+#include "motion_controller.cpp"            //智能车运动控制类
+#include "recognition/cross_recognition.cpp" //十字道路识别与路径规划类
+#include "recognition/freezone_recognition.cpp" //泛行区识别类
+#include "recognition/garage_recognition.cpp"   //车库及斑马线识别类
+#include "recognition/ring_recognition.cpp" //环岛道路识别与路径规划类
+#include "recognition/track_recognition.cpp" //赛道识别基础类
+#include <algorithm>
+#include <iostream>
+#include <opencv2/highgui.hpp> //OpenCV终端部署
+#include <opencv2/opencv.hpp>  //OpenCV终端部署
+using namespace std;
+using namespace cv;
+
+enum RoadType {
+  BaseHandle = 0, // 基础赛道处理
+  RingHandle,     // 环岛赛道处理
+  CrossHandle,    // 十字道路处理
+  FreezoneHandle, // 泛行区处理
+  GarageHandle,   // 车库处理
+  GranaryHandle,  // 粮仓处理
+  DepotHandle,    // 修车厂处理
+  BridgeHandle,   // 坡道(桥)处理
+  SlowzoneHandle, // 慢行区（动物出没）处理
+  FarmlandHandle, // 农田区域处理
+};
+
+class IcarPipeline {
+public:
+  ImagePreprocess imagePreprocess;           // 图像预处理类
+  TrackRecognition trackRecognition;         // 赛道识别
+  ControlCenterCal controlCenterCal;         // 控制中心计算
+  MotionController motionController;         // 运动控制
+  RingRecognition ringRecognition;           // 环岛识别
+  CrossroadRecognition crossroadRecognition; // 十字道路处理
+  GarageRecognition garageRecognition;       // 车库识别
+  FreezoneRecognition freezoneRecognition;   // 泛型区识别类
+  FarmlandDetection farmlandDetection;       // 农田区域检测
+  DepotDetection depotDetection;             // 维修厂检测
+  GranaryDetection granaryDetection;         // 粮仓检测
+  BridgeDetection bridgeDetection;           // 桥梁检测
+  SlowZoneDetection slowZoneDetection;       // 慢行区检测
+
+  RoadType roadType = RoadType::BaseHandle; // 初始化赛道类型
+  Mat imgaeCorrect;                         // RGB矫正图像：仅调试/存图模式下使用
+  Mat imageBinary;                          // Gray
+  uint16_t circlesThis = 2;                 // 智能车当前运行的圈数
+  FrameContext frameContext;                // 单帧共享数据：二值图像/AI检测结果（每帧构建）
+  vector<ElementHandler> elements;          // 赛道元素处理表（按执行顺序）
+  WorkerPool workerPool;                    // 元素检测并行执行线程池
+
+  // 单帧输出：由调用方执行
+  bool buzzer = false;        // 蜂鸣器提醒
+  bool finish = false;        // 结束运行（入库完成/冲出赛道）
+  bool controlEnable = false; // 下发运动控制（启动延时后）
+  float controlSpeed = 0;     // 下发速度（修车厂停车/倒车已处理）
+
+  /**
+   * @brief 初始化：IPM、识别参数与图像矫正（需先读取配置文件）
+   *
+   */
+  void init(void) {
+    ipm.init(Size(COLSIMAGE, ROWSIMAGE),
+             Size(COLSIMAGEIPM, ROWSIMAGEIPM)); // IPM逆透视变换初始化
+
+    trackRecognition.rowCutUp = motionController.params.rowCutUp;
+    trackRecognition.rowCutBottom = motionController.params.rowCutBottom;
+    trackRecognition.trackingEnable = motionController.params.trackingEnable;
+    garageRecognition.disGarageEntry = motionController.params.disGarageEntry;
+
+    if (motionController.params.GarageEnable) // 出入库使能
+      roadType = RoadType::GarageHandle;      // 初始赛道元素为出库
+
+    imagePreprocess.imageCorrecteInit(); // 图像矫正参数初始化
+    imageRgbEnable = motionController.params.debug ||
+                     motionController.params.saveImage; // RGB预处理使能
+    if (motionController.params.correctionRowCut) // 矫正只处理切行区间
+      imagePreprocess.imageCorrectionRows(
+          motionController.params.rowCutUp,
+          motionController.params.rowCutBottom);
+
+    elementsInit();
+    workerPool.init(max(motionController.params.elementThreads - 1, 0));
+  }
+
+  /**
+   * @brief 比赛开始：启动入库倒计时
+   *
+   * @param time 当前时间（ms）
+   */
+  void start(double time) { timeStart = time; }
+
+  /**
+   * @brief 单帧处理：图像预处理 + 识别与控制
+   *
+   * @param frame 原始图像
+   * @param predicts AI检测结果
+   * @param time 当前时间（ms）：实时运行为系统时间，离线回放为帧时间
+   * @param predictsFresh 新的推理结果（false：沿用上次推理的结果）
+   */
+  void process(Mat &frame, vector<PredictResult> &predicts, double time,
+               bool predictsFresh = true) {
+    preprocess(frame, imageBinary);
+    recognize(imageBinary, predicts, time, predictsFresh);
+  }
+
+  /**
+   * @brief 图像预处理（[02]）：矫正/高光抑制/二值化
+   *
+   * @param frame 原始图像
+   * @param binary 输出二值图像：每帧新分配，可交由其他线程识别
+   * @note 流水线模式下与recognize()在不同线程执行，不得访问识别与控制状态
+   */
+  void preprocess(Mat &frame, Mat &binary) {
+    PROFILE_SCOPE("preprocess");
+    int light1 = -50;
+    Mat src;
+    if (imageRgbEnable) { // 调试模式：RGB矫正图像用于显示，二值化同样先灰度化再高光抑制
+      {
+        PROFILE_SCOPE("correction");
+        imgaeCorrect = imagePreprocess.imageCorrection(frame); // RGB
+      }
+      Mat imageGray;
+      {
+        PROFILE_SCOPE("grayscale");
+        imageGray = imagePreprocess.imageGrayscale(imgaeCorrect);
+      }
+      PROFILE_SCOPE("highlight");
+      src = imagePreprocess.imageHighLight(imageGray, light1); // 高光抑制
+    } else { // 灰度模式：先灰度化，矫正/高光抑制/二值化均为单通道
+      Mat imageGray, imageGrayCorrect;
+      {
+        PROFILE_SCOPE("grayscale");
+        imageGray = imagePreprocess.imageGrayscale(frame);
+      }
+      {
+        PROFILE_SCOPE("correction");
+        imageGrayCorrect = imagePreprocess.imageCorrection(imageGray);
+      }
+      PROFILE_SCOPE("highlight");
+      src = imagePreprocess.imageHighLight(imageGrayCorrect, light1);
+    }
+    PROFILE_SCOPE("binarize");
+    binary = imagePreprocess.imageBinaryzation(src);
+  }
+
+  /**
+   * @brief 识别与控制（[03]~[15]）
+   *
+   * @param binary 预处理后的二值图像
+   * @param predicts AI检测结果
+   * @param time 当前时间（ms）
+   * @param predictsFresh 新的推理结果（false：沿用上次推理的结果）
+   */
+  void recognize(Mat &binary, vector<PredictResult> &predicts, double time,
+                 bool predictsFresh = true) {
+    bool imshowRec = false; // 特殊赛道图像显示标志
+    buzzer = false;
+    controlEnable = false;
+    timeNow = time;
+    ringTimerUpdate();
+
+    imageBinary = binary;
+    imagePreprocess.predictsCorrection(predicts); // 检测框转换到矫正图像坐标系（与赛道边缘一致）
+    frameContext.build(imageBinary, predicts, time,
+                       predictsFresh); // 元素识别模块共享，不再逐个拷贝
+
+    //[03] 基础赛道识别
+    {
+      PROFILE_SCOPE("track");
+      trackRecognition.trackRecognition(
+          imageBinary); // 赛道线识别   可以尝试修改成八领域巡线
+    }
+    if (motionController.params.debug) {
+      Mat imageTrack = imgaeCorrect.clone(); // RGB
+      trackRecognition.drawImage(imageTrack); // 图像显示赛道线识别结果
+      imshow("imageTrack", imageTrack);
+      savePicture(imageTrack);
+    }
+
+    // [04]~[12] 赛道元素识别与路径规划：元素处理中只执行该元素，基础赛道下只执行触发条件成立的元素
+    for (int i = 0; i < elements.size(); i++) {
+      if (roadType == RoadType::BaseHandle && elements[i].parallel &&
+          workerPool.size() > 0) // 基础赛道：相邻的并行表项同时执行
+      {
+        int end = i;
+        while (end < elements.size() && elements[end].parallel)
+          end++;
+        elementsParallel(i, end, imshowRec);
+        i = end - 1;
+        continue;
+      }
+
+      ElementHandler &element = elements[i];
+      if (!elementReady(element))
+        continue;
+      elementApply(element, element.execute(), imshowRec);
+      if (finish) // 入库完成
+        return;
+    }
+
+    // [13] 控制中心计算
+    if (trackRecognition.pointsEdgeLeft.size() < 30 &&
+        trackRecognition.pointsEdgeRight.size() < 30 &&
+        roadType != RoadType::BridgeHandle &&
+        roadType != RoadType::GranaryHandle &&
+        roadType != RoadType::DepotHandle &&
+        roadType != RoadType::FarmlandHandle) // 防止车辆冲出赛道
+    {
+      counterOutTrackA++;
+      counterOutTrackB = 0;
+      if (counterOutTrackA > 20) {
+        finish = true;
+        return;
+      }
+    } else {
+      counterOutTrackB++;
+      if (counterOutTrackB > 50) {
+        counterOutTrackA = 0;
+        counterOutTrackB = 50;
+      }
+    }
+
+    {
+      PROFILE_SCOPE("control_center");
+      controlCenterCal.controlCenterCal(
+          trackRecognition); // 根据赛道边缘信息拟合运动控制中心
+    }
+
+    // [14] 运动控制
+    if (counterRunBegin > 30) ////智能车启动延时：前几场图像不稳定
+    {
+      PROFILE_SCOPE("motion");
+      // 智能汽车方向控制
+      if (roadType != RoadType::RingHandle)
+        motionController.pdController(
+            controlCenterCal.controlCenter); // PD控制器姿态控制圆环pid单独控制
+      else if (roadType == RoadType::RingHandle) {
+        if (motionController.params.ringDirection == 0)
+          motionController.RingpdController(controlCenterCal.controlCenter);
+        else if (motionController.params.ringDirection == 1)
+          motionController.RightRingpdController(
+              controlCenterCal.controlCenter);
+      }
+      // 智能汽车速度控制
+      switch (roadType) {
+      case RoadType::GarageHandle:
+        motionController.motorSpeed =
+            motionController.params.speedGarage; // 匀速控制
+        break;
+      case RoadType::BridgeHandle:
+        motionController.motorSpeed =
+            motionController.params.speedBridge; // 匀速控制
+        break;
+      case RoadType::SlowzoneHandle:
+        motionController.motorSpeed =
+            motionController.params.speedSlowzone; // 匀速控制
+        break;
+      case RoadType::RingHandle:
+        motionController.motorSpeed = motionController.params.speedRing;
+        break;
+      case RoadType::CrossHandle:
+        motionController.motorSpeed = motionController.params.speedcross;
+        break;
+      default:                                              // 基础巡线
+        motionController.speedController(true, slowDown,
+                                         controlCenterCal); // 变加速控制
+        break;
+      }
+
+      // 下发速度：修车厂停车/倒车
+      controlEnable = true;
+      controlSpeed = motionController.motorSpeed;
+      if (roadType == RoadType::DepotHandle) {
+        if (depotDetection.depotStep == 4)
+          controlSpeed = 0;
+        else if (depotDetection.depotStep == 5)
+          controlSpeed = -motionController.motorSpeed;
+      }
+
+      // 减速缓冲
+      if (slowDown) {
+        counterSlowDown++;
+        if (counterSlowDown > 50) {
+          slowDown = false;
+          counterSlowDown = 0;
+        }
+      }
+    } else
+      counterRunBegin++;
+
+    // [15]调试模式下图像显示和存图
+    if (motionController.params.debug) {
+      controlCenterCal.drawImage(trackRecognition, imgaeCorrect);
+      switch (roadType) {
+      case RoadType::BaseHandle: // 基础赛道处理 // 基础赛道处理
+        putText(imgaeCorrect, "[1] Track", Point(10, 20),
+                cv::FONT_HERSHEY_TRIPLEX, 0.3, cv::Scalar(0, 0, 255), 1,
+                CV_AA);          // 显示赛道识别类型
+        break;
+      case RoadType::RingHandle: // 环岛赛道处理 // 环岛赛道处理
+        putText(imgaeCorrect, "[2] Ring", Point(10, 20),
+                cv::FONT_HERSHEY_TRIPLEX, 0.3, cv::Scalar(0, 255, 0), 1,
+                CV_AA);           // 显示赛道识别类型
+        break;
+      case RoadType::CrossHandle: // 十字道路处理 // 十字道路处理
+        putText(imgaeCorrect, "[3] Cross", Point(10, 20),
+                cv::FONT_HERSHEY_TRIPLEX, 0.3, cv::Scalar(0, 255, 0), 1,
+                CV_AA);              // 显示赛道识别类型
+        break;
+      case RoadType::FreezoneHandle: // 泛行区处理 // 泛行区处理
+        putText(imgaeCorrect, "[4] Freezone", Point(10, 20),
+                cv::FONT_HERSHEY_TRIPLEX, 0.3, cv::Scalar(0, 255, 0), 1,
+                CV_AA);            // 显示赛道识别类型
+        break;
+      case RoadType::GarageHandle: // 车库处理 // 车库处理
+        putText(imgaeCorrect, "[5] Garage", Point(10, 20),
+                cv::FONT_HERSHEY_TRIPLEX, 0.3, cv::Scalar(0, 255, 0), 1,
+                CV_AA);             // 显示赛道识别类型
+        break;
+      case RoadType::GranaryHandle: // 粮仓处理 // 加油站处理
+        putText(imgaeCorrect, "[6] Granary", Point(10, 20),
+                cv::FONT_HERSHEY_TRIPLEX, 0.3, cv::Scalar(0, 255, 0), 1,
+                CV_AA);           // 显示赛道识别类型
+        break;
+      case RoadType::DepotHandle: // 修车厂处理 // 施工区处理
+        putText(imgaeCorrect, "[7] Depot", Point(10, 20),
+                cv::FONT_HERSHEY_TRIPLEX, 0.3, cv::Scalar(0, 255, 0), 1,
+                CV_AA);            // 显示赛道识别类型
+        break;
+      case RoadType::BridgeHandle: // 坡道(桥)处理 // 坡道处理
+        putText(imgaeCorrect, "[8] Bridge", Point(10, 20),
+                cv::FONT_HERSHEY_TRIPLEX, 0.3, cv::Scalar(0, 255, 0), 1,
+                CV_AA);              // 显示赛道识别类型
+        break;
+      case RoadType::SlowzoneHandle: // 慢行区（动物出没）处理 // 坡道处理
+        putText(imgaeCorrect, "[9] Slowzone", Point(10, 20),
+                cv::FONT_HERSHEY_TRIPLEX, 0.3, cv::Scalar(0, 255, 0), 1,
+                CV_AA);              // 显示赛道识别类型
+        break;
+      case RoadType::FarmlandHandle: // 农田区域处理 // 坡道处理
+        putText(imgaeCorrect, "[10] Farmland", Point(10, 20),
+                cv::FONT_HERSHEY_TRIPLEX, 0.3, cv::Scalar(0, 255, 0), 1,
+                CV_AA); // 显示赛道识别类型
+        break;
+      }
+
+      putText(imgaeCorrect,
+              "v: " + formatDoble2String(motionController.motorSpeed, 2),
+              Point(COLSIMAGE - 60, 80), FONT_HERSHEY_PLAIN, 1,
+              Scalar(0, 0, 255), 1); // 车速
+
+      string str = to_string(circlesThis) + "/" +
+                   to_string(motionController.params.circles);
+      putText(imgaeCorrect, str, Point(COLSIMAGE - 50, ROWSIMAGE - 20),
+              cv::FONT_HERSHEY_TRIPLEX, 0.5, cv::Scalar(0, 255, 0), 1,
+              CV_AA); // 显示圈数
+      if (!imshowRec) // 保持调试图像存储顺序和显示一致性
+      {
+        Mat imageNone =
+            Mat::zeros(Size(COLSIMAGE, ROWSIMAGE), CV_8UC3); // 初始化图像
+        imshow("imageRecognition", imageNone);
+        savePicture(imageNone);
+      }
+      imshow("imageControl", imgaeCorrect);
+      savePicture(imgaeCorrect);
+
+      char c = waitKey(1);
+    }
+  }
+
+  /**
+   * @brief 赛道元素处理耗时统计输出
+   *
+   */
+  void printElementTiming(void) {
+    ::printElementTiming(elements, frameContext.frameId);
+  }
+
+  /**
+   * @brief 车辆减速使能
+   *
+   */
+  void slowDownEnable(void) {
+    slowDown = true;
+    counterSlowDown = 0;
+  }
+
+private:
+  bool imageRgbEnable = false;   // RGB预处理使能
+  uint16_t counterRunBegin = 1;  // 智能车启动计数器：等待摄像头图像帧稳定
+  uint16_t counterOutTrackA = 0; // 车辆冲出赛道计数器A
+  uint16_t counterOutTrackB = 0; // 车辆冲出赛道计数器B
+  uint16_t countercircles = 0;   // 圈数计数器
+  bool slowDown = false;         // 特殊区域减速标志
+  uint16_t counterSlowDown = 0;  // 减速计数器
+
+  double timeNow = 0;                        // 当前时间（ms）
+  double timeStart = -1;                     // 比赛开始时间（ms，-1：未开始）
+  bool allowRingState = true;                // 初始设定允许"圆环状态"
+  vector<pair<double, bool>> ringTimerEvents; // 圆环状态倒计时事件：（时间，状态）
+
+  vector<int> candidates;        // 并行执行的表项序号（按优先级）
+  vector<char> candidateResults; // 并行执行结果
+
+  /**
+   * @brief 元素执行条件：使能，且为当前处理中的元素或基础赛道下触发条件成立
+   *
+   */
+  bool elementReady(ElementHandler &element) {
+    if (!element.enable()) // 赛道元素是否使能
+      return false;
+    if (roadType == element.roadType)
+      return true;
+    if (roadType != RoadType::BaseHandle) // 其他元素处理中
+      return false;
+    if (!element.triggered(frameContext.predicts)) {
+      element.skips++;
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief 元素执行结果：更新赛道类型，初次识别提醒与调试绘图
+   *
+   */
+  void elementApply(ElementHandler &element, bool result, bool &imshowRec) {
+    if (!result) {
+      roadType = RoadType::BaseHandle;
+      return;
+    }
+
+    if (roadType == RoadType::BaseHandle && element.enter) // 初次识别
+      element.enter();
+    roadType = (RoadType)element.roadType;
+    if (finish)
+      return;
+    if (motionController.params.debug && element.draw) {
+      Mat imageElement =
+          Mat::zeros(Size(COLSIMAGE, ROWSIMAGE), CV_8UC3); // 初始化图像
+      element.draw(imageElement);
+      imshow("imageRecognition", imageElement);
+      imshowRec = true;
+      savePicture(imageElement);
+    }
+  }
+
+  /**
+   * @brief 基础赛道下并行执行表项[begin, end)，再按表序依次应用结果
+   *
+   * 与串行执行结果一致：首个识别成功的元素之后的表项在串行时不会执行，回滚其模块状态
+   */
+  void elementsParallel(int begin, int end, bool &imshowRec) {
+    candidates.clear();
+    for (int i = begin; i < end; i++) {
+      if (elementReady(elements[i]))
+        candidates.push_back(i);
+    }
+    for (int k = 1; k < candidates.size(); k++) // 首项不会回滚
+      elements[candidates[k]].save();
+
+    candidateResults.resize(candidates.size());
+    workerPool.run(candidates.size(), [this](int k) {
+      candidateResults[k] = elements[candidates[k]].execute();
+    });
+
+    for (int k = 0; k < candidates.size(); k++) {
+      ElementHandler &element = elements[candidates[k]];
+      if (roadType != RoadType::BaseHandle) // 已有元素识别成功
+        element.restore();
+      else
+        elementApply(element, candidateResults[k], imshowRec);
+    }
+  }
+
+  /**
+   * @brief 赛道元素处理表：执行顺序、触发条件与处理流程
+   *
+   * 触发条件为模块在基础赛道下产生动作的必要条件：AI标志类元素由标志类别触发，
+   * 标志计数/处理中的帧由模块状态（busy）保持执行；十字/泛行区由赛道几何特征触发；
+   * 出入库（圈数计数/起点检测）与环岛（屏蔽计数/补线行更新）的状态逐帧更新，不设触发条件；
+   * AI标志类元素在基础赛道下只读赛道边缘与检测结果，可并行执行（elementThreads > 1）
+   */
+  void elementsInit(void) {
+    elements.clear();
+
+    // [04] 出库和入库识别与路径规划
+    ElementHandler garage;
+    garage.roadType = RoadType::GarageHandle;
+    garage.name = "garage";
+    garage.enable = [this] { return motionController.params.GarageEnable; };
+    garage.busy = [] { return true; };
+    garage.run = [this] {
+      countercircles++; // 圈数计数
+      if (countercircles > 200)
+        countercircles = 200;
+      if (garageRecognition.startingCheck(frameContext)) // 检测到起点
+      {
+        if (roadType == RoadType::BaseHandle) // 初次识别-蜂鸣器提醒
+          buzzer = true;
+
+        bridgeDetection.reset();
+        depotDetection.reset();
+        farmlandDetection.reset();
+        granaryDetection.reset();
+        slowZoneDetection.reset();
+        crossroadRecognition.reset();
+        freezoneRecognition.reset(); // 泛行区识别复位
+        ringRecognition.reset();     // 环岛识别初始化
+
+        if (countercircles > 60) {
+          circlesThis++;
+          countercircles = 0;
+        }
+      }
+
+      if (circlesThis >= motionController.params.circles &&
+          countercircles > 100 && timeAllowStart()) // 入库使能：跑完N圈
+        garageRecognition.entryEnable = true;
+
+      bool result =
+          garageRecognition.garageRecognition(trackRecognition, frameContext);
+      if (result && garageRecognition.garageStep ==
+                        garageRecognition.GarageEntryFinish) // 入库完成
+      {
+        cout << ">>>>>>>   入库结束 !!!!!" << endl;
+        finish = true;
+        return true;
+      }
+      if (garageRecognition.slowDown) // 入库减速
+        slowDownEnable();
+      return result;
+    };
+    garage.enter = [this] { buzzer = true; };
+    garage.draw = [this](Mat &image) {
+      garageRecognition.drawImage(trackRecognition, image);
+    };
+    elements.push_back(garage);
+
+    //[05] 农田区域检测
+    ElementHandler farmland;
+    farmland.roadType = RoadType::FarmlandHandle;
+    farmland.name = "farmland";
+    farmland.enable = [this] { return motionController.params.FarmlandEnable; };
+    farmland.labels = {LABEL_CORN};
+    farmland.busy = [this] { return farmlandDetection.busy(); };
+    farmland.run = [this] {
+      return farmlandDetection.farmlandDetection(trackRecognition, frameContext);
+    };
+    farmland.enter = [this] { buzzer = true; };
+    farmland.draw = [this](Mat &image) {
+      farmlandDetection.drawImage(trackRecognition, image);
+    };
+    farmland.parallelEnable(farmlandDetection);
+    elements.push_back(farmland);
+
+    //[06] 维修厂检测
+    ElementHandler depot;
+    depot.roadType = RoadType::DepotHandle;
+    depot.name = "depot";
+    depot.enable = [this] { return motionController.params.DepotEnable; };
+    depot.labels = {LABEL_TRACTOR};
+    depot.busy = [this] { return depotDetection.busy(); };
+    depot.run = [this] {
+      return depotDetection.depotDetection(trackRecognition, frameContext);
+    };
+    depot.enter = [this] { buzzer = true; };
+    depot.draw = [this](Mat &image) {
+      depotDetection.drawImage(trackRecognition, image);
+    };
+    depot.parallelEnable(depotDetection);
+    elements.push_back(depot);
+
+    //[07] 粮仓检测
+    ElementHandler granary;
+    granary.roadType = RoadType::GranaryHandle;
+    granary.name = "granary";
+    granary.enable = [this] { return motionController.params.GranaryEnable; };
+    granary.labels = {LABEL_GRANARY};
+    granary.busy = [this] { return granaryDetection.busy(); };
+    granary.run = [this] {
+      return granaryDetection.granaryDetection(trackRecognition, frameContext);
+    };
+    granary.enter = [this] { buzzer = true; };
+    granary.draw = [this](Mat &image) {
+      granaryDetection.drawImage(trackRecognition, image);
+    };
+    granary.parallelEnable(granaryDetection);
+    elements.push_back(granary);
+
+    // [08] 坡道（桥）检测与路径规划
+    ElementHandler bridge;
+    bridge.roadType = RoadType::BridgeHandle;
+    bridge.name = "bridge";
+    bridge.enable = [this] { return motionController.params.BridgeEnable; };
+    bridge.labels = {LABEL_BRIDGE};
+    bridge.busy = [this] { return bridgeDetection.busy(); };
+    bridge.run = [this] {
+      return bridgeDetection.bridgeDetection(trackRecognition, frameContext);
+    };
+    bridge.enter = [this] { buzzer = true; };
+    bridge.draw = [this](Mat &image) {
+      bridgeDetection.drawImage(trackRecognition, image);
+    };
+    bridge.parallelEnable(bridgeDetection);
+    elements.push_back(bridge);
+
+    // [09] 慢行区检测与路径规划
+    ElementHandler slowzone;
+    slowzone.roadType = RoadType::SlowzoneHandle;
+    slowzone.name = "slowzone";
+    slowzone.enable = [this] { return motionController.params.SlowzoneEnable; };
+    slowzone.labels = {LABEL_BUMP, LABEL_PIG};
+    slowzone.busy = [this] { return slowZoneDetection.busy(); };
+    slowzone.run = [this] {
+      return slowZoneDetection.slowZoneDetection(trackRecognition, frameContext);
+    };
+    slowzone.enter = [this] { buzzer = true; };
+    slowzone.draw = [this](Mat &image) {
+      slowZoneDetection.drawImage(trackRecognition, image);
+    };
+    slowzone.parallelEnable(slowZoneDetection);
+    elements.push_back(slowzone);
+
+    // [10] 泛行区检测与识别：岔路点触发
+    ElementHandler freezone;
+    freezone.roadType = RoadType::FreezoneHandle;
+    freezone.name = "freezone";
+    freezone.enable = [this] { return motionController.params.FreezoneEnable; };
+    freezone.geometry = [this] { return !trackRecognition.spurroad.empty(); };
+    freezone.busy = [this] { return freezoneRecognition.busy(); };
+    freezone.run = [this] {
+      return freezoneRecognition.freezoneRecognition(trackRecognition);
+    };
+    freezone.enter = [this] { buzzer = true; };
+    freezone.draw = [this](Mat &image) {
+      freezoneRecognition.drawImage(trackRecognition, image);
+    };
+    elements.push_back(freezone);
+
+    // [11] 环岛识别与路径规划（左右圆环准备分开的暂时去除了右圆环）
+    ElementHandler ring;
+    ring.roadType = RoadType::RingHandle;
+    ring.name = "ring";
+    ring.enable = [this] {
+      return motionController.params.RingEnable && allowRingState &&
+             motionController.params.ringDirection == 0;
+    };
+    ring.busy = [] { return true; };
+    ring.run = [this] {
+      return ringRecognition.ringRecognition(trackRecognition, frameContext);
+    };
+    ring.enter = [this] {
+      buzzer = true;
+      ringTimerStart(); // 圆环状态倒计时
+    };
+    elements.push_back(ring);
+
+    // [12] 十字道路处理：左右边缘均超过半幅图像（十字有效行限制）
+    ElementHandler cross;
+    cross.roadType = RoadType::CrossHandle;
+    cross.name = "cross";
+    cross.enable = [this] { return motionController.params.CrossEnable; };
+    cross.geometry = [this] {
+      return trackRecognition.pointsEdgeLeft.size() >= ROWSIMAGE / 2 &&
+             trackRecognition.pointsEdgeRight.size() >= ROWSIMAGE / 2;
+    };
+    cross.run = [this] {
+      return crossroadRecognition.crossroadRecognition(trackRecognition,
+                                                       frameContext);
+    };
+    elements.push_back(cross);
+  }
+
+  /**
+   * @brief 入库使能倒计时：比赛开始70秒后允许入库
+   *
+   */
+  bool timeAllowStart(void) {
+    return timeStart >= 0 && timeNow - timeStart >= 70000;
+  }
+
+  /**
+   * @brief 圆环状态倒计时：识别到圆环5秒后禁止圆环，35秒后允许，50秒后禁止
+   * @note 由于第二圈肯定没有圆环所以第一次5秒后禁止圆环后35秒后才解放(除非学弟学妹们车能上2m)
+   */
+  void ringTimerStart(void) {
+    ringTimerEvents.emplace_back(timeNow + 5000, false);
+    ringTimerEvents.emplace_back(timeNow + 35000, true);
+    ringTimerEvents.emplace_back(timeNow + 50000, false);
+    stable_sort(ringTimerEvents.begin(), ringTimerEvents.end(),
+                [](const pair<double, bool> &a, const pair<double, bool> &b) {
+                  return a.first < b.first;
+                });
+  }
+
+  /**
+   * @brief 圆环状态倒计时：执行到期的事件
+   *
+   */
+  void ringTimerUpdate(void) {
+    while (!ringTimerEvents.empty() && ringTimerEvents[0].first <= timeNow) {
+      allowRingState = ringTimerEvents[0].second;
+      ringTimerEvents.erase(ringTimerEvents.begin());
+    }
+  }
+};
@@ -26,6 +26,7 @@
 #include <opencv2/highgui.hpp>
 #include <opencv2/opencv.hpp>
 #include "../include/common.hpp"
+#include "../include/predict_result.hpp"
 
 using namespace cv;
 using namespace std;
@@ -33,8 +34,11 @@ using namespace std;
 /**
 **[1] 读取视频
 **[2] 图像二值化
+**[3] 图像高光抑制
 */
 
+#define HIGHLIGHT_BUCKETS 64 // 高光抑制：像素亮度比率量化等级
+
 class ImagePreprocess
 {
 public:
@@ -48,16 +52,124 @@ public:
 	{
 		Mat imageGray, imageBinary;
 
-		cvtColor(frame, imageGray, COLOR_BGR2GRAY); // RGB转灰度图
+		if (frame.channels() == 1) // 灰度图直接二值化
+			imageGray = frame;
+		else
+			cvtColor(frame, imageGray, COLOR_BGR2GRAY); // RGB转灰度图
 
 		threshold(imageGray, imageBinary, 0, 255, THRESH_OTSU); // OTSU二值化方法
 
 		return imageBinary;
 	}
 
+	/**
+	 * @brief 图像灰度化（灰度模式预处理的第一步）
+	 *
+	 * @param frame 输入原始帧：BGR / YUYV(CV_8UC2) / 灰度
+	 * @return Mat 灰度图像（YUYV直接取Y分量）
+	 */
+	Mat imageGrayscale(Mat &frame)
+	{
+		if (frame.channels() == 1)
+			return frame;
+
+		if (frame.channels() == 2)
+			cvtColor(frame, imageLuma, COLOR_YUV2GRAY_YUYV); // 直接提取Y分量
+		else
+			cvtColor(frame, imageLuma, COLOR_BGR2GRAY);
+		return imageLuma;
+	}
+
+	/**
+	 * @brief 图像高光抑制（8bit查表实现）
+	 *
+	 * @param image 输入RGB图像或灰度图像
+	 * @param light 高光调节量（负数为抑制）
+	 * @return Mat 处理后的图像（复用内部缓存，下一帧处理时会被覆盖）
+	 * @note 每个像素的调节系数只由其灰度决定：rate = min(gray^2 / mean(gray^2), 1)
+	 *       将rate量化为HIGHLIGHT_BUCKETS级，每帧预计算[等级][像素值]的结果表，逐像素只需查表
+	 */
+	Mat imageHighLight(Mat &image, int light)
+	{
+		Mat gray = image; // 灰度图直接使用
+		if (image.channels() != 1)
+		{
+			cvtColor(image, imageGray, COLOR_BGR2GRAY); // 定点灰度化（OpenCV内部NEON/SSE加速）
+			gray = imageGray;
+		}
+
+		// 灰度直方图 -> 高光阈值：mean(gray^2)
+		int histogram[256] = {0};
+		for (int i = 0; i < gray.rows; i++)
+		{
+			const uchar *g = gray.ptr<uchar>(i);
+			for (int j = 0; j < gray.cols; j++)
+				histogram[g[j]]++;
+		}
+		double thresh = 0;
+		for (int i = 0; i < 256; i++)
+			thresh += histogram[i] * (i / 255.0) * (i / 255.0);
+		thresh /= max(gray.total(), (size_t)1);
+
+		// 灰度 -> 比率等级
+		for (int i = 0; i < 256; i++)
+		{
+			double rate = 1.0; // 高光区
+			if (thresh > 0)
+				rate = min((i / 255.0) * (i / 255.0) / thresh, 1.0);
+			bucketGray[i] = (uchar)(rate * (HIGHLIGHT_BUCKETS - 1) + 0.5);
+		}
+
+		// 比率等级 x 像素值 -> 输出像素值
+		int maxLight = 4;
+		float bright = light / 100.0f / maxLight;
+		float mid = 1.0f + maxLight * bright;
+		for (int b = 0; b < HIGHLIGHT_BUCKETS; b++)
+		{
+			float rate = (float)b / (HIGHLIGHT_BUCKETS - 1);
+			float midRate = (mid - 1.0f) * rate + 1.0f;
+			float brightRate = rate * bright;
+			for (int v = 0; v < 256; v++)
+			{
+				float temp = pow(v / 255.f, 1.0f / midRate) * (1.0 / (1 - brightRate));
+				temp = temp > 1.0f ? 1.0f : (temp < 0.0f ? 0.0f : temp);
+				highLightLut[b][v] = uchar(255 * temp);
+			}
+		}
+
+		// 灰度图：等级与像素值都由灰度决定，合并为一张256项的表
+		if (image.channels() == 1)
+		{
+			Mat lutGray(1, 256, CV_8UC1);
+			for (int v = 0; v < 256; v++)
+				lutGray.at<uchar>(v) = highLightLut[bucketGray[v]][v];
+			LUT(image, lutGray, imageLight);
+			return imageLight;
+		}
+
+		// 逐像素查表
+		imageLight.create(image.size(), image.type());
+		for (int i = 0; i < image.rows; i++)
+		{
+			const uchar *in = image.ptr<uchar>(i);
+			const uchar *g = gray.ptr<uchar>(i);
+			uchar *out = imageLight.ptr<uchar>(i);
+			for (int j = 0; j < image.cols; j++)
+			{
+				const uchar *lut = highLightLut[bucketGray[g[j]]];
+				out[3 * j] = lut[in[3 * j]];
+				out[3 * j + 1] = lut[in[3 * j + 1]];
+				out[3 * j + 2] = lut[in[3 * j + 2]];
+			}
+		}
+
+		return imageLight;
+	}
+
 	/**
 	 * @brief 图像矫正参数初始化
 	 *
+	 * @note 矫正映射表只在初始化时计算一次（CV_16SC2定点格式），避免每帧重复initUndistortRectifyMap
 	 */
 	void imageCorrecteInit(void)
 	{
@@ -71,6 +183,7 @@ public:
 			file["distCoeffs"] >> distCoeffs;
 			cout << "相机矫正参数初始化成功!" << endl;
 			correctionEnable = true;
+			correctionMapsInit(Size(COLSIMAGE, ROWSIMAGE)); // 预计算矫正映射表
 		}
 		else
 		{
@@ -79,27 +192,47 @@ public:
 		}
 	}
 
+	/**
+	 * @brief 设置矫正的有效行区间（只对[rowUp, ROWS-rowBottom)进行remap，其余行直接拷贝原图）
+	 *
+	 * @param rowUp 图像顶部切行
+	 * @param rowBottom 图像底部切行
+	 * @note rowUp = rowBottom = 0 时矫正整幅图像（默认）
+	 */
+	void imageCorrectionRows(uint16_t rowUp, uint16_t rowBottom)
+	{
+		rowCorrectUp = rowUp;
+		rowCorrectBottom = rowBottom;
+	}
+
 	/**
 	 * @brief 矫正图像
 	 *
-	 * @param imagesPath 图像路径
+	 * @param image 原始图像
+	 * @return Mat 矫正后的图像（复用内部缓存，下一帧矫正时会被覆盖）
 	 */
 	Mat imageCorrection(Mat &image)
 	{
 		if (correctionEnable)
 		{
-			Size sizeImage; // 图像的尺寸
-			sizeImage.width = image.cols;
-			sizeImage.height = image.rows;
+			if (image.size() != sizeMaps) // 输入分辨率变化时重新计算映射表
+				correctionMapsInit(image.size());
 
-			Mat mapx = Mat(sizeImage, CV_32FC1);	// 经过矫正后的X坐标重映射参数
-			Mat mapy = Mat(sizeImage, CV_32FC1);	// 经过矫正后的Y坐标重映射参数
-			Mat rotMatrix = Mat::eye(3, 3, CV_32F); // 内参矩阵与畸变矩阵之间的旋转矩阵
+			imageCorrect.create(image.size(), image.type()); // 尺寸不变时不会重新分配内存
 
-			// 采用initUndistortRectifyMap+remap进行图像矫正
-			initUndistortRectifyMap(cameraMatrix, distCoeffs, rotMatrix, cameraMatrix, sizeImage, CV_32FC1, mapx, mapy);
-			Mat imageCorrect = image.clone();
-			remap(image, imageCorrect, mapx, mapy, INTER_LINEAR);
+			int rowUp = min<int>(rowCorrectUp, image.rows);
+			int rowBottom = max<int>(image.rows - rowCorrectBottom, rowUp);
+			if (rowUp > 0)
+				image.rowRange(0, rowUp).copyTo(imageCorrect.rowRange(0, rowUp));
+			if (rowBottom < image.rows)
+				image.rowRange(rowBottom, image.rows).copyTo(imageCorrect.rowRange(rowBottom, image.rows));
+
+			// 映射表记录的是原图中的绝对坐标，因此可以只对目标行区间remap
+			if (rowBottom > rowUp)
+			{
+				Mat imageRows = imageCorrect.rowRange(rowUp, rowBottom);
+				remap(image, imageRows, mapx.rowRange(rowUp, rowBottom), mapy.rowRange(rowUp, rowBottom), INTER_LINEAR);
+			}
 
 			// 采用undistort进行图像矫正
 			//  undistort(image, imageCorrect, cameraMatrix, distCoeffs);
@@ -112,8 +245,69 @@ public:
 		}
 	}
 
+	/**
+	 * @brief AI检测框矫正：原始图像坐标 -> 矫正图像坐标
+	 *
+	 * @param predicts AI检测结果（原位修改为四角矫正后的外接矩形）
+	 * @note AI推理在未矫正的原始帧上进行，赛道边缘取自矫正图像；检测框转换后，元素识别中锥桶/标志
+	 *       与赛道边缘的比较、ipm.homography俯视投影均在同一坐标系下进行
+	 */
+	void predictsCorrection(vector<PredictResult> &predicts)
+	{
+		if (!correctionEnable || predicts.empty())
+			return;
+
+		pointsBox.clear();
+		for (const PredictResult &result : predicts) // 检测框四角：左上/右上/左下/右下
+		{
+			pointsBox.emplace_back(result.x, result.y);
+			pointsBox.emplace_back(result.x + result.width, result.y);
+			pointsBox.emplace_back(result.x, result.y + result.height);
+			pointsBox.emplace_back(result.x + result.width, result.y + result.height);
+		}
+		undistortPoints(pointsBox, pointsBoxCorrect, cameraMatrix, distCoeffs, noArray(), cameraMatrix);
+
+		for (int i = 0; i < predicts.size(); i++)
+		{
+			const Point2f *corner = &pointsBoxCorrect[4 * i];
+			int left = max(cvRound(min(corner[0].x, corner[2].x)), 0); // 限制在图像内
+			int right = min(cvRound(max(corner[1].x, corner[3].x)), sizeMaps.width);
+			int top = max(cvRound(min(corner[0].y, corner[1].y)), 0);
+			int bottom = min(cvRound(max(corner[2].y, corner[3].y)), sizeMaps.height);
+			predicts[i].x = left;
+			predicts[i].y = top;
+			predicts[i].width = max(right - left, 0);
+			predicts[i].height = max(bottom - top, 0);
+		}
+	}
+
 private:
 	bool correctionEnable = false; // 图像矫正使能：初始化完成
 	Mat cameraMatrix;			   // 摄像机内参矩阵
 	Mat distCoeffs;				   // 相机的畸变矩阵
+	Mat mapx;					   // 矫正映射表：CV_16SC2定点坐标
+	Mat mapy;					   // 矫正映射表：CV_16UC1插值系数
+	Size sizeMaps;				   // 映射表对应的图像尺寸
+	Mat imageCorrect;			   // 矫正图像输出缓存（每帧复用）
+	uint16_t rowCorrectUp = 0;	   // 矫正区域顶部切行
+	uint16_t rowCorrectBottom = 0; // 矫正区域底部切行
+	Mat imageGray;				   // 高光抑制：灰度缓存
+	Mat imageLight;				   // 高光抑制：输出缓存（每帧复用）
+	uchar highLightLut[HIGHLIGHT_BUCKETS][256]; // 高光抑制：[比率等级][像素值]结果表
+	uchar bucketGray[256];					   // 高光抑制：灰度 -> 比率等级
+	Mat imageLuma;							   // 灰度模式：灰度化输出缓存
+	vector<Point2f> pointsBox;				   // 检测框矫正：原始图像四角坐标（识别线程）
+	vector<Point2f> pointsBoxCorrect;		   // 检测框矫正：矫正后的四角坐标
+
+	/**
+	 * @brief 计算矫正映射表
+	 *
+	 * @param sizeImage 图像尺寸
+	 */
+	void correctionMapsInit(Size sizeImage)
+	{
+		Mat rotMatrix = Mat::eye(3, 3, CV_32F); // 内参矩阵与畸变矩阵之间的旋转矩阵
+		initUndistortRectifyMap(cameraMatrix, distCoeffs, rotMatrix, cameraMatrix, sizeImage, CV_16SC2, mapx, mapy);
+		sizeMaps = sizeImage;
+	}
 };
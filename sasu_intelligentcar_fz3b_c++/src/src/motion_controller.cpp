@@ -25,10 +25,13 @@
 using namespace std;
 using nlohmann::json;
 
-int a = 0;
 class MotionController {
 private:
-  int counterShift = 0; // 变速计数器
+  int counterShift = 0;       // 变速计数器
+  int errorLast = 0;          // 前一次的偏差：巡线（按实例保存，支持多条流水线）
+  int errorLastRing = 0;      // 前一次的偏差：左圆环
+  int errorLastRightRing = 0; // 前一次的偏差：右圆环
+  bool ringFirst = true;      // 首次圆环控制：沿用巡线比例系数
 
 public:
   /**
@@ -56,8 +59,25 @@ public:
     int ringDirection = 0;
     bool debug = false;         // 调试模式使能
     bool saveImage = false;     // 存图使能
+    int recordSlots = 8;        // 异步存图队列槽位数
+    bool recordBlock = false;   // 存图队满时等待（false：丢弃当前帧）
+    bool runLogEnable = false;  // 运行日志：逐帧记录原始图像/AI结果/控制输出
+    bool runLogJpeg = false;    // 运行日志图像JPEG编码（false：原始数据）
+    bool profileEnable = true;  // 分阶段耗时统计（退出/SIGUSR1时输出）
+    bool profileCounters = false; // 分阶段硬件计数器统计（perf_event）
+    bool profileTrace = false;    // 退出时导出线程时间线（Chrome trace）
     uint16_t rowCutUp = 10;     // 图像顶部切行
     uint16_t rowCutBottom = 10; // 图像顶部切行
+    bool correctionRowCut = false; // 矫正只处理切行区间
+    bool trackingEnable = false;   // 赛道边缘帧间跟踪使能
+    bool frameWait = true;         // 等待AI新帧（false：不阻塞，取最新帧）
+    bool v4l2Enable = false;       // V4L2 mmap零拷贝采集
+    bool v4l2Mjpeg = false;        // V4L2像素格式：MJPEG（false：YUYV）
+    int v4l2Buffers = 6;           // V4L2驱动缓存队列深度
+    int elementThreads = 1;        // 基础赛道元素检测并行线程数（含主线程，1：串行）
+    bool pipelineEnable = false;   // 预处理/识别控制分级流水线（非调试模式）
+    int pipelineDepth = 2;         // 流水线在途帧数（1：各级不重叠，延迟最低）
+    vector<int> pipelineCores = {2, 3}; // 流水线各级绑定的CPU核（-1：不绑定）
     float disGarageEntry = 0.7; // 车库入库距离(斑马线Image占比)
     bool GarageEnable = true;   // 出入库使能
     bool BridgeEnable = true;   // 坡道使能
@@ -74,9 +94,13 @@ public:
         Params, speedcross, rightP1, rightP2, ringDirection, ringP1, ringP2,
         speedRing, speedLow, speedHigh, speedDown, speedBridge, speedSlowzone,
         speedGarage, runP1, runP2, runP3, turnP, turnD, debug, saveImage,
-        rowCutUp, rowCutBottom, disGarageEntry, GarageEnable, BridgeEnable,
-        FreezoneEnable, RingEnable, CrossEnable, GranaryEnable, DepotEnable,
-        FarmlandEnable, SlowzoneEnable, circles, pathVideo); // 添加构造函数
+        recordSlots, recordBlock, runLogEnable, runLogJpeg, profileEnable,
+        profileCounters, profileTrace, rowCutUp, rowCutBottom, correctionRowCut, trackingEnable, frameWait,
+        v4l2Enable, v4l2Mjpeg, v4l2Buffers, elementThreads, pipelineEnable,
+        pipelineDepth, pipelineCores, disGarageEntry,
+        GarageEnable, BridgeEnable, FreezoneEnable, RingEnable, CrossEnable,
+        GranaryEnable, DepotEnable, FarmlandEnable, SlowzoneEnable, circles,
+        pathVideo); // 添加构造函数
   };
 
   Params params;                   // 读取控制参数
@@ -92,7 +116,6 @@ public:
   void pdController(int controlCenter) {
     float heightest_line = 0;
     float error = controlCenter - COLSIMAGE / 2; // 图像控制中心转换偏差
-    static int errorLast = 0;                    // 记录前一次的偏差
     if (abs(error - errorLast) > COLSIMAGE / 10) {
       error = error > errorLast ? errorLast + COLSIMAGE / 10
                                 : errorLast - COLSIMAGE / 10;
@@ -108,14 +131,13 @@ public:
 
   void RingpdController(int controlCenter) {
     float error = controlCenter - COLSIMAGE / 2; // 图像控制中心转换偏差
-    static int errorLast = 0;                    // 记录前一次的偏差
-    if (abs(error - errorLast) > COLSIMAGE / 10) {
-      error = error > errorLast ? errorLast + COLSIMAGE / 10
-                                : errorLast - COLSIMAGE / 10;
+    if (abs(error - errorLastRing) > COLSIMAGE / 10) {
+      error = error > errorLastRing ? errorLastRing + COLSIMAGE / 10
+                                    : errorLastRing - COLSIMAGE / 10;
     }
-    if (a == 0) {
+    if (ringFirst) {
       params.turnP = tmp;
-      a++;
+      ringFirst = false;
     } else
       params.turnP = abs(error) * params.ringP2 + params.ringP1;
     // turnP = max(turnP,0.2);
@@ -124,18 +146,19 @@ public:
     //  }
     // turnP = runP1 + heightest_line * runP2;
 
-    int pwmDiff = (error * params.turnP) + (error - errorLast) * params.turnD;
-    errorLast = error;
+    int pwmDiff =
+        (error * params.turnP) + (error - errorLastRing) * params.turnD;
+    errorLastRing = error;
 
     servoPwm = (uint16_t)(PWMSERVOMID + pwmDiff); // PWM转换
   }
 
   void RightRingpdController(int controlCenter) {
     float error = controlCenter - COLSIMAGE / 2; // 图像控制中心转换偏差
-    static int errorLast = 0;                    // 记录前一次的偏差
-    if (abs(error - errorLast) > COLSIMAGE / 10) {
-      error = error > errorLast ? errorLast + COLSIMAGE / 10
-                                : errorLast - COLSIMAGE / 10;
+    if (abs(error - errorLastRightRing) > COLSIMAGE / 10) {
+      error = error > errorLastRightRing
+                  ? errorLastRightRing + COLSIMAGE / 10
+                  : errorLastRightRing - COLSIMAGE / 10;
     }
 
     params.turnP = abs(error) * params.rightP2 + params.rightP1;
@@ -145,8 +168,9 @@ public:
     //  }
     // turnP = runP1 + heightest_line * runP2;
 
-    int pwmDiff = (error * params.turnP) + (error - errorLast) * params.turnD;
-    errorLast = error;
+    int pwmDiff =
+        (error * params.turnP) + (error - errorLastRightRing) * params.turnD;
+    errorLastRightRing = error;
 
     servoPwm = (uint16_t)(PWMSERVOMID + pwmDiff); // PWM转换
   }
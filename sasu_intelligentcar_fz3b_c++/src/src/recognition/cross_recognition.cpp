@@ -33,7 +33,7 @@
 #include <opencv2/opencv.hpp>
 #include "../../include/common.hpp"
 #include "track_recognition.cpp"
-#include "../../include/predictor.hpp"
+#include "../../include/frame_context.hpp"
 
 using namespace cv;
 using namespace std;
@@ -54,9 +54,9 @@ public:
      * @brief 十字道路识别与图像处理
      *
      * @param track 赛道识别结果
-     * @param imagePath 输入图像
+     * @param frame 单帧共享数据（二值图像/AI检测结果）
      */
-    bool crossroadRecognition(TrackRecognition &track, vector<PredictResult> predict)
+    bool crossroadRecognition(TrackRecognition &track, const FrameContext &frame)
     {
         bool repaired = false;               // 十字识别与补线结果
         crossroadType = CrossroadType::None; // 十字道路类型
@@ -309,7 +309,7 @@ public:
      *
      * @param Image 需要叠加显示的图像/RGB
      */
-    void drawImage(TrackRecognition track, Mat &Image)
+    void drawImage(const TrackRecognition &track, Mat &Image)
     {
         // 绘制边缘点
         for (int i = 0; i < track.pointsEdgeLeft.size(); i++)
@@ -395,7 +395,7 @@ private:
      * @param pointsEdgeLeft
      * @return uint16_t
      */
-    uint16_t searchBreakLeftUp(vector<POINT> pointsEdgeLeft)
+    uint16_t searchBreakLeftUp(const vector<POINT> &pointsEdgeLeft)
     {
         uint16_t rowBreakLeftUp = pointsEdgeLeft.size() - 5;
         uint16_t counter = 0;
@@ -424,7 +424,7 @@ private:
      * @param pointsEdgeLeft
      * @return uint16_t
      */
-    uint16_t searchBreakLeftDown(vector<POINT> pointsEdgeLeft)
+    uint16_t searchBreakLeftDown(const vector<POINT> &pointsEdgeLeft)
     {
         uint16_t rowBreakLeft = 0;
         uint16_t counter = 0;
@@ -452,7 +452,7 @@ private:
      * @param pointsEdgeRight
      * @return uint16_t
      */
-    uint16_t searchBreakRightUp(vector<POINT> pointsEdgeRight)
+    uint16_t searchBreakRightUp(const vector<POINT> &pointsEdgeRight)
     {
         uint16_t rowBreakRightUp = pointsEdgeRight.size() - 5;
         uint16_t counter = 0;
@@ -481,7 +481,7 @@ private:
      * @param pointsEdgeRight
      * @return uint16_t
      */
-    uint16_t searchBreakRightDown(vector<POINT> pointsEdgeRight)
+    uint16_t searchBreakRightDown(const vector<POINT> &pointsEdgeRight)
     {
         uint16_t rowBreakRightDown = 0;
         uint16_t counter = 0;
@@ -523,7 +523,7 @@ private:
      * @return true
      * @return false
      */
-    bool searchStraightCrossroad(vector<POINT> pointsEdgeLeft, vector<POINT> pointsEdgeRight)
+    bool searchStraightCrossroad(const vector<POINT> &pointsEdgeLeft, const vector<POINT> &pointsEdgeRight)
     {
         if (pointsEdgeLeft.size() < ROWSIMAGE * 0.8 || pointsEdgeRight.size() < ROWSIMAGE * 0.8)
         {
@@ -32,7 +32,7 @@
 #include <opencv2/highgui.hpp>
 #include <opencv2/opencv.hpp>
 #include "../../include/common.hpp"
-#include "../../include/predictor.hpp"
+#include "../../include/predict_result.hpp"
 #include "../recognition/track_recognition.cpp"
 
 using namespace cv;
@@ -64,6 +64,16 @@ public:
         counterStep = 0;
     }
 
+    /**
+     * @brief 非空闲：泛行区路径重构中
+     *
+     */
+    bool busy(void)
+    {
+        return freezoneStep == FreezoneStep::FreezoneEntering ||
+               freezoneStep == FreezoneStep::FreezoneExiting;
+    }
+
     /**
      * @brief 泛型区识别与路径规划
      *
@@ -279,7 +289,7 @@ public:
      * @param Image 需要叠加显示的图像/RGB
      * @param imageIpm 需要叠加的俯视域图像/RGB
      */
-    void drawImage(TrackRecognition track, Mat &Image)
+    void drawImage(const TrackRecognition &track, Mat &Image)
     {
         // 绘制边缘点
         for (int i = 0; i < track.pointsEdgeLeft.size(); i++)
@@ -339,7 +349,7 @@ private:
      * @param pointsEdgeLeft
      * @return uint16_t
      */
-    uint16_t searchBreakLeft(vector<POINT> pointsEdgeLeft)
+    uint16_t searchBreakLeft(const vector<POINT> &pointsEdgeLeft)
     {
         uint16_t rowBreakLeft = 0;
         uint16_t counter = 0;
@@ -374,7 +384,7 @@ private:
      * @param pointsEdgeRight
      * @return uint16_t
      */
-    uint16_t searchBreakRight(vector<POINT> pointsEdgeRight)
+    uint16_t searchBreakRight(const vector<POINT> &pointsEdgeRight)
     {
         uint16_t rowBreakRight = 0;
         uint16_t counter = 0;
@@ -14,7 +14,7 @@
  */
 
 #include "../../include/common.hpp"
-#include "../../include/predictor.hpp"
+#include "../../include/frame_context.hpp"
 #include "track_recognition.cpp"
 #include <cmath>
 #include <fstream>
@@ -48,21 +48,17 @@ public:
   /**
    * @brief 起点检测
    *
-   * @param predict
+   * @param frame 单帧共享数据（二值图像/AI检测结果）
    * @return true
    * @return false
    */
-  bool startingCheck(vector<PredictResult> predict) {
+  bool startingCheck(const FrameContext &frame) {
     if (startingFilt) {
-      for (int i = 0; i < predict.size(); i++) {
-        if (predict[i].label == LABEL_CROSSWALK) // 标志检测
-        {
-          counterCrosswalk++;
-          break;
-        }
-      }
+      if (frame.predictsFresh &&
+          frame.predicts.has(LABEL_CROSSWALK)) // 标志检测：同一推理结果只计一次
+        counterCrosswalk++;
 
-      if (counterCrosswalk) {
+      if (counterCrosswalk && frame.predictsFresh) { // 场次按推理结果计
         counterSessionTwo++;
 
         if (counterCrosswalk > 5 && counterSessionTwo < 12) {
@@ -92,15 +88,14 @@ public:
    *
    * @param track
    */
-  bool garageRecognition(TrackRecognition &track,
-                         vector<PredictResult> predict) {
+  bool garageRecognition(TrackRecognition &track, const FrameContext &frame) {
     if (garageStep == GarageStep::GarageExiting) // 出库阶段
     {
       garageExitRecognition(track);
     } else if (entryEnable) // 入库阶段：入库使能
     {
-      // garageEntryRecognition(track, predict);
-      garageEntryRec(track, predict);
+      // garageEntryRecognition(track, frame);
+      garageEntryRec(track, frame);
     }
 
     if (garageStep == GarageExiting || garageStep == GarageEntryingA ||
@@ -115,19 +110,16 @@ public:
    *
    * @param track 基础赛道识别结果
    */
-  void garageEntryRecognition(TrackRecognition &track,
-                              vector<PredictResult> predict) {
+  void garageEntryRecognition(TrackRecognition &track, const FrameContext &frame) {
     _pointRU = POINT(0, 0);
     _pointLU = POINT(0, 0);
     _pointRD = POINT(0, 0);
     _Index = "-";
     slowDown = false;
 
-    POINT crosswalk = searchCrosswalkSign(predict);
-    if (crosswalk.x > 0)
-      counterRec++;
-    else
-      counterRec = 0;
+    POINT crosswalk = searchCrosswalkSign(frame.predicts);
+    if (frame.predictsFresh) // 同一推理结果只计一次
+      counterRec = crosswalk.x > 0 ? counterRec + 1 : 0;
 
     if (counterRec > 15 &&
         garageStep ==
@@ -367,17 +359,19 @@ public:
    *
    * @param track 基础赛道识别结果
    */
-  void garageEntryRec(TrackRecognition &track, vector<PredictResult> predict) {
+  void garageEntryRec(TrackRecognition &track, const FrameContext &frame) {
     _Index = "-";
     slowDown = false;
     _crosswalk = POINT(0, 0);
 
-    POINT crosswalk = searchCrosswalkSign(predict);
+    POINT crosswalk = searchCrosswalkSign(frame.predicts);
     _crosswalk = crosswalk;
-    if (crosswalk.x > 0 && track.stdevRight < 50)
+    if (frame.predictsFresh && crosswalk.x > 0 &&
+        track.stdevRight < 50) // 同一推理结果只计一次
       counterRec++;
     if (counterRec) {
-      counterSession++;
+      if (frame.predictsFresh) // 场次按推理结果计
+        counterSession++;
       if (garageStep == GarageEntryRecognition) {
         if (counterRec > 4 &&
             garageStep ==
@@ -550,7 +544,7 @@ public:
    * @param track 赛道识别结果
    * @param trackImage 输入叠加图像
    */
-  void drawImage(TrackRecognition &track, Mat &trackImage) {
+  void drawImage(const TrackRecognition &track, Mat &trackImage) {
     // 赛道边缘
     for (int i = 0; i < track.pointsEdgeLeft.size(); i++) {
       circle(trackImage,
@@ -666,7 +660,7 @@ private:
    * @param pointsEdgeRight
    * @return uint16_t
    */
-  uint16_t searchBreakLeftUp(vector<POINT> pointsEdgeLeft) {
+  uint16_t searchBreakLeftUp(const vector<POINT> &pointsEdgeLeft) {
     if (pointsEdgeLeft.size() < 5)
       return 0;
 
@@ -695,7 +689,7 @@ private:
    * @param pointsEdgeRight
    * @return uint16_t
    */
-  uint16_t searchBreakRightDown(vector<POINT> pointsEdgeRight) {
+  uint16_t searchBreakRightDown(const vector<POINT> &pointsEdgeRight) {
 
     uint16_t rowBreakRightDown = 0;
     uint16_t counter = 0;
@@ -783,7 +777,7 @@ private:
    * @param spurroad 岔路集合
    * @return POINT 岔路坐标
    */
-  POINT searchBestSpurroad(vector<POINT> spurroad) {
+  POINT searchBestSpurroad(const vector<POINT> &spurroad) {
     if (spurroad.size() < 1)
       return POINT(0, 0);
 
@@ -810,15 +804,12 @@ private:
    * @param predict
    * @return POINT
    */
-  POINT searchCrosswalkSign(vector<PredictResult> predict) {
+  POINT searchCrosswalkSign(const PredictIndex &predict) {
     POINT crosswalk(0, 0);
-    for (int i = 0; i < predict.size(); i++) {
-      if (predict[i].label == LABEL_CROSSWALK) // 标志检测
-      {
-        return POINT(predict[i].y + predict[i].height / 2,
-                     predict[i].x + predict[i].width / 2);
-      }
-    }
+    const vector<PredictResult> &signs = predict[LABEL_CROSSWALK];
+    if (!signs.empty()) // 标志检测
+      return POINT(signs[0].y + signs[0].height / 2,
+                   signs[0].x + signs[0].width / 2);
 
     return crosswalk;
   }
@@ -29,6 +29,7 @@
  */
 
 #include "../../include/common.hpp"
+#include "../../include/frame_context.hpp"
 #include "track_recognition.cpp"
 #include <cmath>
 #include <fstream>
@@ -59,9 +60,9 @@ public:
    * @brief 环岛识别与行径规划
    *
    * @param track 基础赛道识别结果
-   * @param imagePath 赛道路径图像
+   * @param frame 单帧共享数据（二值图像/AI检测结果）
    */
-  bool ringRecognition(TrackRecognition &track, Mat &imagePath) {
+  bool ringRecognition(TrackRecognition &track, const FrameContext &frame) {
     if (counterShield < 40) {
       counterShield++;
       return false;
@@ -295,7 +296,7 @@ public:
                kkk <
                track.pointsEdgeRight[track.pointsEdgeRight.size() - 1].x + 50;
                kkk++) {
-            if (imagePath.at<Vec3b>(kkk, 0)[2] > 0) {
+            if (frame.imageBinary.at<Vec3b>(kkk, 0)[2] > 0) {
               x_end = kkk;
               break;
             }
@@ -511,7 +512,7 @@ public:
    *
    * @param ringImage 需要叠加显示的图像
    */
-  void drawImage(TrackRecognition track, Mat &ringImage) {
+  void drawImage(const TrackRecognition &track, Mat &ringImage) {
     for (int i = 0; i < track.pointsEdgeLeft.size(); i++) {
       circle(ringImage,
              Point(track.pointsEdgeLeft[i].y, track.pointsEdgeLeft[i].x), 2,
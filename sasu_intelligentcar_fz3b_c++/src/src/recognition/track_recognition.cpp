@@ -27,6 +27,11 @@
 #include <opencv2/highgui.hpp>
 #include <opencv2/opencv.hpp>
 #include "../../include/common.hpp"
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 using namespace cv;
 using namespace std;
@@ -45,6 +50,14 @@ public:
     POINT garageEnable = POINT(0, 0); // 车库识别标志：（x=1/0，y=row)
     uint16_t rowCutUp = 10;           // 图像顶部切行
     uint16_t rowCutBottom = 10;       // 图像底部切行
+    bool runLengthEnable = true;      // 色块搜索方式：位掩码游程提取（false：逐像素搜索）
+    bool trackingEnable = false;      // 帧间跟踪：在上一帧同行边缘附近开窗搜索（false：整行搜索）
+    uint16_t trackingWindow = 8;      // 帧间跟踪窗口半宽（像素）
+    uint16_t trackingRefresh = 10;    // 连续跟踪帧数上限：超过后强制整行搜索一帧
+    uint32_t trackingHits = 0;        // 帧间跟踪命中行数
+    uint32_t trackingMisses = 0;      // 帧间跟踪失败（回退整行搜索）行数
+    uint32_t trackingFrames = 0;      // 帧间跟踪帧数
+    uint32_t trackingFullFrames = 0;  // 整行搜索帧数（低置信度/周期刷新）
 
     /**
      * @brief 赛道线识别
@@ -56,8 +69,8 @@ public:
     {
         bool flagStartBlock = true;                    // 搜索到色块起始行的标志（行）
         int counterSearchRows = pointsEdgeLeft.size(); // 搜索行计数
-        int startBlock[30];                            // 色块起点（行）
-        int endBlock[30];                              // 色块终点（行）
+        int startBlock[30] = {0};                      // 色块起点（行）
+        int endBlock[30] = {0};                        // 色块终点（行）
         int counterBlock = 0;                          // 色块计数器（行）
         POINT pointSpurroad;                           // 岔路坐标
         int counterSpurroad = 0;                       // 岔路识别标志
@@ -99,67 +112,27 @@ public:
         //  开始识别赛道左右边缘
         for (int row = rowStart; row > rowCutUp; row--) // 有效行：10~220
         {
-            counterBlock = 0; // 色块计数器清空
             // 搜索色（block）块信息
-            if (imageType == ImageType::Rgb) // 输入RGB图像
+            bool tracked = false; // 帧间跟踪命中
+            if (trackingActive && !flagStartBlock)
             {
-                if (imagePath.at<Vec3b>(row, 1)[2] > 0)
+                tracked = searchBlockTracking(row, startBlock[0], endBlock[0]);
+                if (tracked && !garageEnable.x && countBlocks(row) > 5)
+                    tracked = false; // 跟踪只校验边缘附近：整行色块数满足斑马线条件时按整行搜索判定车库
+                else if (tracked)
                 {
-                    startBlock[counterBlock] = 0;
-                }
-                for (int col = 1; col < COLSIMAGE; col++) // 搜索出每行的所有色块
-                {
-                    if (imagePath.at<Vec3b>(row, col)[2] > 0 &&
-                        imagePath.at<Vec3b>(row, col - 1)[2] == 0)
-                    {
-                        startBlock[counterBlock] = col;
-                    }
-                    else
-                    {
-                        if (imagePath.at<Vec3b>(row, col)[2] == 0 &&
-                            imagePath.at<Vec3b>(row, col - 1)[2] > 0)
-                        {
-                            endBlock[counterBlock++] = col;
-                            if (counterBlock >= end(endBlock) - begin(endBlock))
-                                break;
-                        }
-                    }
-                }
-                if (imagePath.at<Vec3b>(row, COLSIMAGE - 1)[2] > 0)
-                {
-                    if (counterBlock < end(endBlock) - begin(endBlock) - 1)
-                        endBlock[counterBlock++] = COLSIMAGE - 1;
+                    counterBlock = 1;
+                    trackingHits++;
                 }
+                else
+                    trackingMisses++;
             }
-            if (imageType == ImageType::Binary) // 输入二值化图像
+            if (!tracked)
             {
-                if (imagePath.at<uchar>(row, 1) > 127)
-                {
-                    startBlock[counterBlock] = 0;
-                }
-                for (int col = 1; col < COLSIMAGE; col++) // 搜索出每行的所有色块
-                {
-                    if (imagePath.at<uchar>(row, col) > 127 &&
-                        imagePath.at<uchar>(row, col - 1) <= 127)
-                    {
-                        startBlock[counterBlock] = col;
-                    }
-                    else
-                    {
-                        if (imagePath.at<uchar>(row, col) <= 127 &&
-                            imagePath.at<uchar>(row, col - 1) > 127)
-                        {
-                            endBlock[counterBlock++] = col;
-                            if (counterBlock >= end(endBlock) - begin(endBlock))
-                                break;
-                        }
-                    }
-                }
-                if (imagePath.at<uchar>(row, COLSIMAGE - 1) > 127)
-                {
-                    if (counterBlock < end(endBlock) - begin(endBlock) - 1)
-                        endBlock[counterBlock++] = COLSIMAGE - 1;
-                }
+                if (runLengthEnable)
+                    counterBlock = searchBlocks(row, startBlock, endBlock, end(endBlock) - begin(endBlock));
+                else
+                    counterBlock = searchBlocksScalar(row, startBlock, endBlock, end(endBlock) - begin(endBlock));
             }
 
             int widthBlocks = endBlock[0] - startBlock[0]; // 色块宽度临时变量
@@ -365,7 +338,54 @@ public:
     void trackRecognition(Mat &imageBinary)
     {
         imagePath = imageBinary;
+
+        // 帧间跟踪：上一帧置信度足够且未到刷新周期时启用
+        trackingActive = trackingEnable && trackingValid && imageType == ImageType::Binary &&
+                         counterTracking < trackingRefresh;
+        if (trackingActive)
+        {
+            counterTracking++;
+            trackingFrames++;
+        }
+        else
+        {
+            counterTracking = 0;
+            if (trackingEnable)
+                trackingFullFrames++;
+        }
+
+        uint32_t missesLast = trackingMisses;
         trackRecognition(false, 0);
+        trackingActive = false; // 重复搜索（isResearch）一律整行搜索
+
+        if (trackingEnable)
+            trackingUpdate(trackingMisses - missesLast);
+    }
+
+    /**
+     * @brief 帧间跟踪统计清零
+     *
+     */
+    void trackingReset(void)
+    {
+        trackingHits = 0;
+        trackingMisses = 0;
+        trackingFrames = 0;
+        trackingFullFrames = 0;
+        trackingValid = false;
+        counterTracking = 0;
+    }
+
+    /**
+     * @brief 帧间跟踪命中率
+     *
+     * @return double 命中行数/跟踪行数
+     */
+    double trackingRatio(void)
+    {
+        if (trackingHits + trackingMisses == 0)
+            return 0;
+        return (double)trackingHits / (trackingHits + trackingMisses);
     }
 
     /**
@@ -432,8 +452,269 @@ public:
             return 0;
     }
 
+    /**
+     * @brief 搜索一行中的所有色块：逐像素比较（参考实现）
+     *
+     * @param row 行号
+     * @param startBlock 色块起点
+     * @param endBlock 色块终点
+     * @param maxBlocks 色块数量上限
+     * @return int 色块数量
+     */
+    int searchBlocksScalar(int row, int startBlock[], int endBlock[], int maxBlocks)
+    {
+        int counterBlock = 0;
+        if (imageType == ImageType::Rgb) // 输入RGB图像
+        {
+            if (imagePath.at<Vec3b>(row, 1)[2] > 0)
+            {
+                startBlock[counterBlock] = 0;
+            }
+            for (int col = 1; col < COLSIMAGE; col++) // 搜索出每行的所有色块
+            {
+                if (imagePath.at<Vec3b>(row, col)[2] > 0 &&
+                    imagePath.at<Vec3b>(row, col - 1)[2] == 0)
+                {
+                    startBlock[counterBlock] = col;
+                }
+                else
+                {
+                    if (imagePath.at<Vec3b>(row, col)[2] == 0 &&
+                        imagePath.at<Vec3b>(row, col - 1)[2] > 0)
+                    {
+                        endBlock[counterBlock++] = col;
+                        if (counterBlock >= maxBlocks)
+                            return counterBlock;
+                    }
+                }
+            }
+            if (imagePath.at<Vec3b>(row, COLSIMAGE - 1)[2] > 0)
+            {
+                if (counterBlock < maxBlocks - 1)
+                    endBlock[counterBlock++] = COLSIMAGE - 1;
+            }
+        }
+        if (imageType == ImageType::Binary) // 输入二值化图像
+        {
+            if (imagePath.at<uchar>(row, 1) > 127)
+            {
+                startBlock[counterBlock] = 0;
+            }
+            for (int col = 1; col < COLSIMAGE; col++) // 搜索出每行的所有色块
+            {
+                if (imagePath.at<uchar>(row, col) > 127 &&
+                    imagePath.at<uchar>(row, col - 1) <= 127)
+                {
+                    startBlock[counterBlock] = col;
+                }
+                else
+                {
+                    if (imagePath.at<uchar>(row, col) <= 127 &&
+                        imagePath.at<uchar>(row, col - 1) > 127)
+                    {
+                        endBlock[counterBlock++] = col;
+                        if (counterBlock >= maxBlocks)
+                            return counterBlock;
+                    }
+                }
+            }
+            if (imagePath.at<uchar>(row, COLSIMAGE - 1) > 127)
+            {
+                if (counterBlock < maxBlocks - 1)
+                    endBlock[counterBlock++] = COLSIMAGE - 1;
+            }
+        }
+        return counterBlock;
+    }
+
+    /**
+     * @brief 搜索一行中的所有色块：位掩码游程提取
+     *
+     * @param row 行号
+     * @param startBlock 色块起点
+     * @param endBlock 色块终点
+     * @param maxBlocks 色块数量上限
+     * @return int 色块数量
+     * @note 每16个像素生成一次白色位掩码，相邻位异或得到跳变位，ctz逐个取出跳变列，
+     *       结果与searchBlocksScalar完全一致
+     */
+    int searchBlocks(int row, int startBlock[], int endBlock[], int maxBlocks)
+    {
+        const int words = (COLSIMAGE + 63) / 64;
+        uchar rowRed[COLSIMAGE]; // RGB图像：红色通道 > 0 映射为白色
+        const uchar *data = imagePath.ptr<uchar>(row);
+        if (imageType == ImageType::Rgb)
+        {
+            const Vec3b *pixels = imagePath.ptr<Vec3b>(row);
+            for (int col = 0; col < COLSIMAGE; col++)
+                rowRed[col] = pixels[col][2] > 0 ? 255 : 0;
+            data = rowRed;
+        }
+
+        uint64_t mask[words]; // 白色像素位掩码：bit=1表示像素>127
+        rowMask(data, COLSIMAGE, mask);
+
+        int counterBlock = 0;
+        if (data[1] > 127)
+        {
+            startBlock[counterBlock] = 0;
+        }
+        uint64_t carry = 0; // 上一个字的最高位（前一列）
+        for (int w = 0; w < words; w++)
+        {
+            uint64_t edges = mask[w] ^ ((mask[w] << 1) | carry); // 跳变位：与前一列不同
+            carry = mask[w] >> 63;
+            if (w == 0)
+                edges &= ~1ull; // 第0列没有前一列
+            if (w == words - 1 && COLSIMAGE % 64)
+                edges &= (1ull << (COLSIMAGE % 64)) - 1;
+
+            while (edges)
+            {
+                int bit = __builtin_ctzll(edges);
+                int col = w * 64 + bit;
+                if ((mask[w] >> bit) & 1) // 上升沿：色块起点
+                {
+                    startBlock[counterBlock] = col;
+                }
+                else // 下降沿：色块终点
+                {
+                    endBlock[counterBlock++] = col;
+                    if (counterBlock >= maxBlocks)
+                        return counterBlock;
+                }
+                edges &= edges - 1;
+            }
+        }
+        if (data[COLSIMAGE - 1] > 127)
+        {
+            if (counterBlock < maxBlocks - 1)
+                endBlock[counterBlock++] = COLSIMAGE - 1;
+        }
+        return counterBlock;
+    }
+
+    /**
+     * @brief 整行色块计数（二值化图像）：只统计下降沿，不记录色块坐标
+     *
+     * @param row 行号
+     * @return int 色块数量（与searchBlocks一致，不设上限）
+     */
+    int countBlocks(int row)
+    {
+        const int words = (COLSIMAGE + 63) / 64;
+        const uchar *data = imagePath.ptr<uchar>(row);
+        uint64_t mask[words];
+        rowMask(data, COLSIMAGE, mask);
+
+        int counterBlock = data[COLSIMAGE - 1] > 127 ? 1 : 0; // 色块贴右边界
+        uint64_t carry = 0;
+        for (int w = 0; w < words; w++)
+        {
+            uint64_t falling = ~mask[w] & ((mask[w] << 1) | carry); // 下降沿：前一列白、本列黑
+            carry = mask[w] >> 63;
+            if (w == words - 1 && COLSIMAGE % 64)
+                falling &= (1ull << (COLSIMAGE % 64)) - 1;
+            counterBlock += __builtin_popcountll(falling);
+        }
+        return counterBlock;
+    }
+
+    /**
+     * @brief 帧间跟踪：在上一帧同行边缘附近的窗口内搜索赛道色块
+     *
+     * @param row 行号
+     * @param start 色块起点
+     * @param end 色块终点
+     * @return true 命中：窗口内各有唯一跳变，且色块两侧一个窗口宽度内无其它色块
+     * @return false 失败：需回退整行搜索
+     * @note 命中时的色块与整行搜索的连通性择优结果一致，仅跳过窗口外的像素
+     */
+    bool searchBlockTracking(int row, int &start, int &end)
+    {
+        int left = lastEdgeLeft[row];
+        int right = lastEdgeRight[row];
+        if (left < 0 || right <= left || pointsEdgeLeft.empty() || pointsEdgeRight.empty())
+            return false;
+
+        const uchar *data = imagePath.ptr<uchar>(row);
+        const int window = trackingWindow;
+
+        // 左窗口：唯一上升沿
+        int edgeLeft = -1;
+        int colStart = max(1, left - window);
+        int colEnd = min(COLSIMAGE - 1, left + window);
+        for (int col = colStart; col <= colEnd; col++)
+        {
+            if (data[col] > 127 && data[col - 1] <= 127)
+            {
+                if (edgeLeft >= 0)
+                    return false;
+                edgeLeft = col;
+            }
+        }
+        if (edgeLeft < 0 && colStart == 1 && data[0] > 127 && data[1] > 127) // 色块贴左边界
+            edgeLeft = 0;
+        if (edgeLeft < 0)
+            return false;
+
+        // 右窗口：唯一下降沿
+        int edgeRight = -1;
+        colStart = max(edgeLeft + 1, right - window);
+        colEnd = min(COLSIMAGE - 1, right + window);
+        for (int col = colStart; col <= colEnd; col++)
+        {
+            if (data[col] <= 127 && data[col - 1] > 127)
+            {
+                if (edgeRight >= 0)
+                    return false;
+                edgeRight = col;
+            }
+        }
+        bool borderRight = false; // 色块贴右边界
+        if (edgeRight < 0 && colEnd == COLSIMAGE - 1 && data[COLSIMAGE - 1] > 127)
+        {
+            edgeRight = COLSIMAGE - 1;
+            borderRight = true;
+        }
+        if (edgeRight < 0)
+            return false;
+
+        // 与本帧上一行的边缘连续
+        if (abs(edgeLeft - pointsEdgeLeft[pointsEdgeLeft.size() - 1].y) > window ||
+            abs(edgeRight - pointsEdgeRight[pointsEdgeRight.size() - 1].y) > window)
+            return false;
+
+        // 校验区间 [edgeLeft-window-1, edgeRight+window+1)：只允许色块本身为白色
+        // 色块内部无黑色（斑马线/岔路），两侧无可与上一行连通的其它色块
+        int whiteEnd = borderRight ? COLSIMAGE : edgeRight;
+        int spanStart = max(0, edgeLeft - window - 1);
+        int spanEnd = min(COLSIMAGE, whiteEnd + window + 1);
+        uint64_t mask[(COLSIMAGE + 63) / 64];
+        rowMask(data + spanStart, spanEnd - spanStart, mask);
+        for (int w = 0; w < (spanEnd - spanStart + 63) / 64; w++)
+        {
+            int bitStart = max(edgeLeft - spanStart - w * 64, 0);
+            int bitEnd = min(whiteEnd - spanStart - w * 64, 64);
+            uint64_t expect = 0;
+            if (bitEnd > bitStart)
+                expect = (bitEnd - bitStart == 64 ? ~0ull : ((1ull << (bitEnd - bitStart)) - 1)) << bitStart;
+            if (mask[w] != expect)
+                return false;
+        }
+
+        start = edgeLeft;
+        end = edgeRight;
+        return true;
+    }
+
 private:
     Mat imagePath; // 赛道搜索图像
+    int16_t lastEdgeLeft[ROWSIMAGE];  // 上一帧各行的左边缘（-1：无效）
+    int16_t lastEdgeRight[ROWSIMAGE]; // 上一帧各行的右边缘（-1：无效）
+    bool trackingActive = false;      // 当前帧启用帧间跟踪
+    bool trackingValid = false;       // 上一帧结果可用于跟踪
+    uint16_t counterTracking = 0;     // 连续跟踪帧计数
     /**
      * @brief 赛道识别输入图像类型
      *
@@ -490,6 +771,65 @@ private:
         }
     }
 
+    /**
+     * @brief 行像素转换为白色位掩码（bit=1：像素>127，即最高位为1）
+     *
+     * @param data 行像素
+     * @param cols 列数
+     * @param mask 输出位掩码（(cols+63)/64个字）
+     */
+    static void rowMask(const uchar *data, int cols, uint64_t *mask)
+    {
+        for (int w = 0; w < (cols + 63) / 64; w++)
+            mask[w] = 0;
+
+        int col = 0;
+#if defined(__aarch64__)
+        const int8x16_t shifts = {0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7};
+        for (; col + 16 <= cols; col += 16) // 每次比较16个像素
+        {
+            uint8x16_t bits = vshlq_u8(vshrq_n_u8(vld1q_u8(data + col), 7), shifts);
+            uint64_t bits16 = vaddv_u8(vget_low_u8(bits)) | (vaddv_u8(vget_high_u8(bits)) << 8);
+            mask[col / 64] |= bits16 << (col % 64);
+        }
+#elif defined(__SSE2__)
+        for (; col + 16 <= cols; col += 16) // 每次比较16个像素
+        {
+            uint64_t bits16 = (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(data + col)));
+            mask[col / 64] |= bits16 << (col % 64);
+        }
+#endif
+        for (; col < cols; col++)
+        {
+            if (data[col] > 127)
+                mask[col / 64] |= 1ull << (col % 64);
+        }
+    }
+
+    /**
+     * @brief 保存本帧边缘供下一帧跟踪，并评估置信度
+     *
+     * @param misses 本帧跟踪失败行数
+     * @note 存在岔路/斑马线、边缘丢失或跟踪大量失败时，下一帧整行搜索
+     */
+    void trackingUpdate(uint32_t misses)
+    {
+        for (int row = 0; row < ROWSIMAGE; row++)
+        {
+            lastEdgeLeft[row] = -1;
+            lastEdgeRight[row] = -1;
+        }
+        for (int i = 0; i < pointsEdgeLeft.size() && i < pointsEdgeRight.size(); i++)
+        {
+            lastEdgeLeft[pointsEdgeLeft[i].x] = pointsEdgeLeft[i].y;
+            lastEdgeRight[pointsEdgeRight[i].x] = pointsEdgeRight[i].y;
+        }
+
+        trackingValid = spurroad.empty() && !garageEnable.x &&
+                        pointsEdgeLeft.size() >= ROWSIMAGE / 4 &&
+                        misses < pointsEdgeLeft.size() / 2;
+    }
+
     /**
      * @brief 边缘有效行计算：左/右
      *
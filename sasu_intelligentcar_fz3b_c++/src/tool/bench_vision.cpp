@@ -0,0 +1,302 @@
+/**
+ * @file bench_vision.cpp
+ * @author lse
+ * @brief 视觉与控制各阶段微基准：逐次计时，输出吞吐/均值/标准差/百分位，并写出CSV用于回归跟踪
+ * @version 0.1
+ * @date 2023-07-28
+ * @note 在build目录下运行：./bench_vision [视频路径|图像文件夹|运行日志] [测量轮数] [输出CSV] [附加检测数]
+ *       默认使用../res/regression/track/与../res/calibration/corners/下的标定图像，5轮，输出./bench_vision.csv
+ *       像素级阶段（矫正/高光抑制/二值化/IPM映射表与变换）测量160x120、320x240、640x480三种分辨率；
+ *       赛道识别/控制中心/贝塞尔/路径搜索/各元素识别的几何参数按320x240固定，只测量原始分辨率
+ *       每个阶段先预热一轮（不计入），各元素识别每轮从初始状态开始，每帧输入赛道识别结果的副本
+ *       附加检测数：按固定随机种子在每帧中加入标志类目标（与element_benchmark一致），使AI标志类元素进入检测流程
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include "../include/common.hpp"
+#include "../include/frame_source.hpp"
+#include "../src/icar_pipeline.cpp"
+#include "../src/path_searching.cpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <opencv2/opencv.hpp>
+
+using namespace std;
+using namespace cv;
+
+/**
+ * @brief 单个测量项：reset()每轮开始时调用，prepare(i)在每次调用前执行（不计时），run(i)计时
+ *
+ */
+struct BenchStage {
+  string name;
+  Size size;
+  int calls = 0; // 每轮调用次数
+  function<void()> reset;
+  function<void(int)> prepare;
+  function<void(int)> run;
+};
+
+/**
+ * @brief 测量结果（ms）
+ *
+ */
+struct BenchResult {
+  string name;
+  Size size;
+  int samples = 0;
+  double mean = 0, stddev = 0, p50 = 0, p95 = 0, max = 0;
+  double throughput = 0; // 每秒调用次数
+};
+
+BenchResult benchRun(BenchStage &stage, int rounds) {
+  vector<double> samples;
+  samples.reserve(stage.calls * rounds);
+  for (int n = 0; n <= rounds; n++) { // 第0轮预热
+    if (stage.reset)
+      stage.reset();
+    for (int i = 0; i < stage.calls; i++) {
+      if (stage.prepare)
+        stage.prepare(i);
+      auto start = chrono::steady_clock::now();
+      stage.run(i);
+      double time = chrono::duration<double, milli>(
+                        chrono::steady_clock::now() - start)
+                        .count();
+      if (n > 0)
+        samples.push_back(time);
+    }
+  }
+
+  BenchResult result;
+  result.name = stage.name;
+  result.size = stage.size;
+  result.samples = samples.size();
+  if (samples.empty())
+    return result;
+  double sum = 0, sumSquare = 0;
+  for (double time : samples) {
+    sum += time;
+    sumSquare += time * time;
+  }
+  result.mean = sum / samples.size();
+  result.stddev =
+      sqrt(max(sumSquare / samples.size() - result.mean * result.mean, 0.0));
+  sort(samples.begin(), samples.end());
+  result.p50 = samples[samples.size() / 2];
+  result.p95 = samples[min<size_t>(samples.size() * 0.95, samples.size() - 1)];
+  result.max = samples.back();
+  result.throughput = result.mean > 0 ? 1000.0 / result.mean : 0;
+  return result;
+}
+
+/**
+ * @brief 附加检测目标：标志类别/位置/尺寸随机（固定种子，结果可复现）
+ *
+ */
+void appendDetections(vector<PredictResult> &predicts, int count, RNG &rng) {
+  const LabelId labels[] = {LABEL_CORN,   LABEL_TRACTOR, LABEL_GRANARY,
+                            LABEL_BRIDGE, LABEL_PIG,     LABEL_BUMP,
+                            LABEL_CONE,   LABEL_CONE};
+  for (int i = 0; i < count; i++) {
+    PredictResult result;
+    result.type = labels[rng.uniform(0, 8)];
+    result.label = LABEL_NAMES[result.type];
+    result.score = 0.9;
+    result.width = rng.uniform(10, 40);
+    result.height = rng.uniform(10, 40);
+    result.x = rng.uniform(0, COLSIMAGE - result.width);
+    result.y = rng.uniform(0, ROWSIMAGE - result.height);
+    predicts.push_back(result);
+  }
+}
+
+/**
+ * @brief 贝塞尔控制点：左右边缘中线上均匀取4点（与控制中心计算一致的三阶曲线）
+ *
+ */
+vector<POINT> bezierInput(TrackRecognition &track) {
+  vector<POINT> input;
+  int size = min(track.pointsEdgeLeft.size(), track.pointsEdgeRight.size());
+  if (size < 4)
+    return {POINT(ROWSIMAGE - 1, COLSIMAGE / 2), POINT(ROWSIMAGE * 2 / 3, COLSIMAGE / 2),
+            POINT(ROWSIMAGE / 3, COLSIMAGE / 2), POINT(0, COLSIMAGE / 2)};
+  for (int k = 0; k < 4; k++) {
+    int i = (size - 1) * k / 3;
+    input.push_back(POINT((track.pointsEdgeLeft[i].x + track.pointsEdgeRight[i].x) / 2,
+                          (track.pointsEdgeLeft[i].y + track.pointsEdgeRight[i].y) / 2));
+  }
+  return input;
+}
+
+int main(int argc, char *argv[]) {
+  string pathFrames = "../res/regression/track/";
+  int rounds = 5;
+  string pathOutput = "./bench_vision.csv";
+  int extra = 8;
+  if (argc > 1)
+    pathFrames = argv[1];
+  if (argc > 2)
+    rounds = atoi(argv[2]);
+  if (argc > 3)
+    pathOutput = argv[3];
+  if (argc > 4)
+    extra = atoi(argv[4]);
+
+  vector<Mat> frames;
+  FrameSource::load(pathFrames, frames);
+  int recorded = frames.size();
+  FrameSource::load("../res/calibration/corners/", frames);
+  if (frames.empty()) {
+    cout << "Error: no frame in " << pathFrames << endl;
+    return -1;
+  }
+  cout << "frames: " << frames.size() << " (recorded " << recorded
+       << " [" << pathFrames << "], calibration " << frames.size() - recorded
+       << "), rounds: " << rounds << endl;
+
+  vector<BenchStage> stages;
+
+  //[1] 像素级阶段：多分辨率
+  const Size sizes[] = {Size(160, 120), Size(COLSIMAGE, ROWSIMAGE), Size(640, 480)};
+  vector<vector<Mat>> scaled(3), lights(3), binarys(3);
+  ImagePreprocess preprocesses[3]; // 各分辨率独立的矫正映射表/缓存
+  for (int s = 0; s < 3; s++) {
+    preprocesses[s].imageCorrecteInit();
+    for (Mat &frame : frames) {
+      Mat image;
+      resize(frame, image, sizes[s]);
+      scaled[s].push_back(image);
+      Mat imageCorrect = preprocesses[s].imageCorrection(image).clone();
+      lights[s].push_back(preprocesses[s].imageHighLight(imageCorrect, -50).clone());
+      binarys[s].push_back(preprocesses[s].imageBinaryzation(lights[s].back()));
+    }
+  }
+  Mat output;
+  for (int s = 0; s < 3; s++) {
+    Size size = sizes[s];
+    Size sizeIpm(size.width * COLSIMAGEIPM / COLSIMAGE,
+                 size.height * ROWSIMAGEIPM / ROWSIMAGE);
+    int n = frames.size();
+    stages.push_back({"imageCorrection", size, n, nullptr, nullptr,
+                      [&, s](int i) { preprocesses[s].imageCorrection(scaled[s][i]); }});
+    stages.push_back({"imageHighLight", size, n, nullptr, nullptr,
+                      [&, s](int i) { preprocesses[s].imageHighLight(scaled[s][i], -50); }});
+    stages.push_back({"imageBinaryzation", size, n, nullptr, nullptr,
+                      [&, s](int i) { preprocesses[s].imageBinaryzation(lights[s][i]); }});
+    stages.push_back({"ipm.createMaps", size, min(n, 20), nullptr, nullptr,
+                      [=](int i) { ipm.init(size, sizeIpm); }});
+    stages.push_back({"ipm.homography", size, n,
+                      [=] { ipm.init(size, sizeIpm); }, nullptr,
+                      [&, s](int i) { ipm.homography(binarys[s][i], output); }});
+  }
+
+  //[2] 几何与控制阶段：原始分辨率
+  const int native = 1;
+  vector<Mat> &binary = binarys[native];
+  int n = binary.size();
+  vector<TrackRecognition> tracks(n);
+  vector<vector<PredictResult>> predicts(n);
+  RNG rng(0x1CA4);
+  for (int i = 0; i < n; i++) {
+    tracks[i].trackRecognition(binary[i]);
+    appendDetections(predicts[i], extra, rng);
+  }
+
+  TrackRecognition trackRecognition;
+  ControlCenterCal controlCenterCal;
+  PathSearching pathSearching;
+  TrackRecognition track;  // 元素识别输入：赛道识别结果副本（识别会改写边缘）
+  FrameContext context;
+  vector<POINT> controlPoints;
+  vector<Point2d> edgePoints;
+  auto prepareTrack = [&](int i) {
+    track = tracks[i];
+    context.build(binary[i], predicts[i], i * 1000.0 / 30);
+  };
+  Size size = sizes[native];
+  stages.push_back({"trackRecognition", size, n,
+                    [&] { trackRecognition = TrackRecognition(); }, nullptr,
+                    [&](int i) { trackRecognition.trackRecognition(binary[i]); }});
+  stages.push_back({"controlCenterCal", size, n, nullptr,
+                    [&](int i) { track = tracks[i]; },
+                    [&](int i) { controlCenterCal.controlCenterCal(track); }});
+  stages.push_back({"Bezier", size, n, nullptr,
+                    [&](int i) { controlPoints = bezierInput(tracks[i]); },
+                    [&](int i) { Bezier(0.03, controlPoints); }});
+  stages.push_back({"ipm.homography.points", size, n,
+                    [&] { ipm.init(size, Size(COLSIMAGEIPM, ROWSIMAGEIPM)); },
+                    nullptr,
+                    [&](int i) {
+                      edgePoints.clear();
+                      for (POINT &point : tracks[i].pointsEdgeLeft)
+                        edgePoints.push_back(ipm.homography(Point2d(point.y, point.x)));
+                    }});
+  stages.push_back({"pathSearch", size, n, nullptr, nullptr,
+                    [&](int i) { pathSearching.pathSearch(binary[i]); }});
+
+  //[3] 各元素识别：每轮从初始状态开始
+  GarageRecognition garage;
+  RingRecognition ring;
+  CrossroadRecognition cross;
+  FreezoneRecognition freezone;
+  FarmlandDetection farmland;
+  DepotDetection depot;
+  GranaryDetection granary;
+  BridgeDetection bridge;
+  SlowZoneDetection slowzone;
+  stages.push_back({"garage", size, n, [&] { garage = GarageRecognition(); }, prepareTrack,
+                    [&](int i) { garage.garageRecognition(track, context); }});
+  stages.push_back({"ring", size, n, [&] { ring.reset(); }, prepareTrack,
+                    [&](int i) { ring.ringRecognition(track, context); }});
+  stages.push_back({"cross", size, n, [&] { cross.reset(); }, prepareTrack,
+                    [&](int i) { cross.crossroadRecognition(track, context); }});
+  stages.push_back({"freezone", size, n, [&] {
+                      ipm.init(size, Size(COLSIMAGEIPM, ROWSIMAGEIPM)); // 岔路点俯视变换
+                      freezone.reset();
+                    }, prepareTrack,
+                    [&](int i) { freezone.freezoneRecognition(track); }});
+  stages.push_back({"farmland", size, n, [&] { farmland.reset(); }, prepareTrack,
+                    [&](int i) { farmland.farmlandDetection(track, context); }});
+  stages.push_back({"depot", size, n, [&] { depot.reset(); }, prepareTrack,
+                    [&](int i) { depot.depotDetection(track, context); }});
+  stages.push_back({"granary", size, n, [&] { granary.reset(); }, prepareTrack,
+                    [&](int i) { granary.granaryDetection(track, context); }});
+  stages.push_back({"bridge", size, n, [&] { bridge.reset(); }, prepareTrack,
+                    [&](int i) { bridge.bridgeDetection(track, context); }});
+  stages.push_back({"slowzone", size, n, [&] { slowzone.reset(); }, prepareTrack,
+                    [&](int i) { slowzone.slowZoneDetection(track, context); }});
+
+  //[4] 测量与输出
+  ofstream csv(pathOutput);
+  csv << "stage,width,height,samples,mean_ms,stddev_ms,p50_ms,p95_ms,max_ms,"
+         "calls_per_s"
+      << endl;
+  cout << left << setw(24) << "stage" << right << setw(9) << "size"
+       << setw(9) << "mean" << setw(9) << "stddev" << setw(9) << "p50"
+       << setw(9) << "p95" << setw(9) << "max" << setw(11) << "calls/s"
+       << endl;
+  cout << fixed << setprecision(4);
+  for (BenchStage &stage : stages) {
+    BenchResult result = benchRun(stage, rounds);
+    string size = to_string(result.size.width) + "x" + to_string(result.size.height);
+    cout << left << setw(24) << result.name << right << setw(9) << size
+         << setw(9) << result.mean << setw(9) << result.stddev << setw(9)
+         << result.p50 << setw(9) << result.p95 << setw(9) << result.max
+         << setw(11) << setprecision(0) << result.throughput << setprecision(4)
+         << endl;
+    csv << result.name << "," << result.size.width << "," << result.size.height
+        << "," << result.samples << "," << result.mean << "," << result.stddev
+        << "," << result.p50 << "," << result.p95 << "," << result.max << ","
+        << result.throughput << endl;
+  }
+  ipm.init(Size(COLSIMAGE, ROWSIMAGE), Size(COLSIMAGEIPM, ROWSIMAGEIPM));
+
+  cout << "stages: " << stages.size() << " -> " << pathOutput << endl;
+  return 0;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file capture_benchmark.cpp
+ * @author lse
+ * @brief 图像采集：cv::VideoCapture与V4L2 mmap零拷贝采集的帧率及时间戳对比
+ * @version 0.1
+ * @date 2023-07-20
+ * @note 在build目录下运行：./capture_benchmark [设备路径] [帧数] [yuyv|mjpeg]
+ *       默认使用/dev/video0；无摄像头时加载vivid虚拟摄像头：sudo modprobe vivid
+ *       V4L2采集失败或时间戳不递增时返回非0
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include "../include/capture.hpp"
+#include <chrono>
+#include <iostream>
+#include <opencv2/opencv.hpp>
+
+using namespace std;
+using namespace cv;
+
+int main(int argc, char *argv[]) {
+  string device = "/dev/video0";
+  int frames = 300;
+  bool mjpeg = false;
+  if (argc > 1)
+    device = argv[1];
+  if (argc > 2)
+    frames = atoi(argv[2]);
+  if (argc > 3)
+    mjpeg = string(argv[3]) == "mjpeg";
+
+  //[1] cv::VideoCapture
+  double timeOpenCV = 0;
+  {
+    Capture capture;
+    if (capture.open(device) != 0) {
+      cout << "Error: VideoCapture open failed: " << device << endl;
+    } else {
+      Mat frame;
+      capture.read(frame); // 首帧包含启动耗时
+      auto start = chrono::steady_clock::now();
+      for (int i = 0; i < frames; i++)
+        capture.read(frame);
+      timeOpenCV = chrono::duration<double, milli>(
+                       chrono::steady_clock::now() - start)
+                       .count();
+      capture.close();
+      cout << "[VideoCapture] " << frame.cols << "x" << frame.rows << " "
+           << timeOpenCV / frames << "ms/frame" << endl;
+    }
+  }
+
+  //[2] V4L2 mmap
+  CaptureParams params;
+  params.v4l2 = true;
+  params.mjpeg = mjpeg;
+  Capture capture(params);
+  if (capture.open(device) != 0) {
+    cout << "Error: V4L2 open failed: " << device << endl;
+    return -1;
+  }
+
+  Mat frame;
+  capture.read(frame);
+  auto stampLast = capture.timestamp();
+  int errors = 0;
+  double intervalMax = 0, latency = 0;
+  auto start = chrono::steady_clock::now();
+  for (int i = 0; i < frames; i++) {
+    if (!capture.read(frame)) {
+      cout << "Error: frame [" << i << "] read failed!" << endl;
+      errors++;
+      continue;
+    }
+    auto stamp = capture.timestamp();
+    double interval =
+        chrono::duration<double, milli>(stamp - stampLast).count();
+    if (interval <= 0) {
+      cout << "Error: frame [" << i << "] timestamp not increasing!" << endl;
+      errors++;
+    }
+    intervalMax = max(intervalMax, interval);
+    latency += chrono::duration<double, milli>(chrono::steady_clock::now() -
+                                               stamp)
+                   .count();
+    stampLast = stamp;
+  }
+  double timeV4l2 =
+      chrono::duration<double, milli>(chrono::steady_clock::now() - start)
+          .count();
+  capture.close();
+
+  cout << "[V4L2 " << (mjpeg ? "MJPEG" : "YUYV") << "] " << frame.cols << "x"
+       << frame.rows << " " << timeV4l2 / frames << "ms/frame" << endl;
+  cout << "max frame interval: " << intervalMax
+       << "ms, mean capture latency: " << latency / frames << "ms" << endl;
+  if (timeOpenCV > 0)
+    cout << "speedup: " << timeOpenCV / timeV4l2 << "x" << endl;
+  cout << "errors: " << errors << "/" << frames << endl;
+
+  return errors ? 1 : 0;
+}
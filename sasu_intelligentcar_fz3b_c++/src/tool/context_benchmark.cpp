@@ -0,0 +1,135 @@
+/**
+ * @file context_benchmark.cpp
+ * @author lse
+ * @brief 元素识别参数传递：按值传递（旧）的拷贝开销与单帧共享数据（FrameContext，常量引用）的堆内存分配对比
+ * @version 0.1
+ * @date 2023-07-20
+ * @note 在build目录下运行：./context_benchmark [视频路径|图像文件夹|运行日志] [AI结果文件]
+ *       默认使用../res/regression/track/，AI结果文件格式同icar_replay（"-"表示无）
+ *       旧接口的拷贝按实际数据逐项复现：每次模块调用拷贝AI检测结果，
+ *       每次绘图拷贝TrackRecognition，每次拐点搜索拷贝边缘点集
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include "../include/alloc_counter.hpp"
+#include "../include/common.hpp"
+#include "../include/frame_source.hpp"
+#include "../include/recorded_backend.hpp"
+#include "../src/icar_pipeline.cpp"
+#include <iostream>
+#include <map>
+#include <opencv2/opencv.hpp>
+
+using namespace std;
+using namespace cv;
+
+/**
+ * @brief 按值传递的拷贝开销统计
+ *
+ */
+struct CopyCost {
+  uint64_t allocs = 0; // 堆内存分配次数
+  uint64_t bytes = 0;  // 拷贝字节数
+};
+
+int main(int argc, char *argv[]) {
+  string pathFrames = "../res/regression/track/";
+  string pathPredicts = "-";
+  if (argc > 1)
+    pathFrames = argv[1];
+  if (argc > 2)
+    pathPredicts = argv[2];
+
+  FrameSource source;
+  if (!source.open(pathFrames)) {
+    cout << "Error: open failed: " << pathFrames << endl;
+    return -1;
+  }
+  map<int, vector<PredictResult>> predicts;
+  if (pathPredicts != "-")
+    RecordedBackend::load(pathPredicts, predicts);
+
+  IcarPipeline pipeline;
+  pipeline.motionController.loadParams();
+  pipeline.motionController.params.debug = false;
+  pipeline.motionController.params.saveImage = false;
+  pipeline.init();
+  pipeline.start(0);
+  MotionController::Params &params = pipeline.motionController.params;
+  int modules = params.GarageEnable * 2 + params.FarmlandEnable +
+                params.DepotEnable + params.GranaryEnable +
+                params.BridgeEnable + params.SlowzoneEnable +
+                params.CrossEnable; // 基础赛道下每帧传入AI检测结果的模块调用次数
+
+  Mat frame;
+  int counter = 0;
+  uint64_t allocsProcess = 0;
+  CopyCost predictCopy, trackCopy, edgeCopy;
+  vector<PredictResult> empty;
+  while (source.read(frame)) {
+    resize(frame, frame, Size(COLSIMAGE, ROWSIMAGE));
+    auto it = predicts.find(counter);
+    vector<PredictResult> &results = it == predicts.end() ? empty : it->second;
+    empty.clear();
+
+    uint64_t allocs = allocCount();
+    pipeline.process(frame, results, counter * 1000.0 / 30);
+    allocsProcess += allocCount() - allocs;
+    counter++;
+
+    //[1] 旧接口：每个模块按值接收AI检测结果
+    for (int i = 0; i < modules; i++) {
+      allocs = allocCount();
+      vector<PredictResult> copy = results;
+      predictCopy.allocs += allocCount() - allocs;
+      predictCopy.bytes += copy.size() * sizeof(PredictResult);
+    }
+
+    //[2] 旧接口：drawImage按值接收TrackRecognition（调试模式每帧至少两次）
+    TrackRecognition &track = pipeline.trackRecognition;
+    for (int i = 0; i < 2; i++) {
+      allocs = allocCount();
+      TrackRecognition copy = track;
+      trackCopy.allocs += allocCount() - allocs;
+      trackCopy.bytes += (copy.pointsEdgeLeft.size() + copy.pointsEdgeRight.size() +
+                          copy.widthBlock.size() + copy.spurroad.size()) *
+                         sizeof(POINT);
+    }
+
+    //[3] 旧接口：拐点搜索/控制中心计算按值接收边缘点集（左右各一次）
+    allocs = allocCount();
+    {
+      vector<POINT> left = track.pointsEdgeLeft;
+      vector<POINT> right = track.pointsEdgeRight;
+      edgeCopy.bytes += (left.size() + right.size()) * sizeof(POINT);
+    }
+    edgeCopy.allocs += allocCount() - allocs;
+
+    if (pipeline.finish)
+      break;
+  }
+  if (counter == 0) {
+    cout << "Error: no frame in " << pathFrames << endl;
+    return -1;
+  }
+
+  uint64_t legacyAllocs = predictCopy.allocs + trackCopy.allocs + edgeCopy.allocs;
+  uint64_t legacyBytes = predictCopy.bytes + trackCopy.bytes + edgeCopy.bytes;
+  cout << "frames: " << counter << " [" << pathFrames << "]" << endl;
+  cout << "[by value] predict copies : " << (double)predictCopy.allocs / counter
+       << " allocs/frame, " << predictCopy.bytes / counter << " bytes/frame"
+       << endl;
+  cout << "[by value] track copies   : " << (double)trackCopy.allocs / counter
+       << " allocs/frame, " << trackCopy.bytes / counter << " bytes/frame"
+       << endl;
+  cout << "[by value] edge copies    : " << (double)edgeCopy.allocs / counter
+       << " allocs/frame, " << edgeCopy.bytes / counter << " bytes/frame"
+       << endl;
+  cout << "[context]  process        : " << (double)allocsProcess / counter
+       << " allocs/frame" << endl;
+  cout << "removed per frame: " << (double)legacyAllocs / counter
+       << " allocs, " << legacyBytes / counter << " bytes ("
+       << 100.0 * legacyAllocs / (legacyAllocs + allocsProcess)
+       << "% of by-value total)" << endl;
+  return 0;
+}
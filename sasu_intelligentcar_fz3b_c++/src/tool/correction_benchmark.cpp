@@ -0,0 +1,125 @@
+/**
+ * @file correction_benchmark.cpp
+ * @author lse
+ * @brief 图像矫正耗时对比：逐帧计算映射表（旧） vs 预计算定点映射表（新）
+ * @version 0.1
+ * @date 2023-07-20
+ * @note 使用res/calibration/corners中的标定图像，在build目录下运行：./correction_benchmark [循环次数]
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include "../include/common.hpp"
+#include "../src/image_preprocess.cpp"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <opencv2/highgui.hpp>
+#include <opencv2/opencv.hpp>
+
+using namespace std;
+using namespace cv;
+
+/**
+ * @brief 旧版矫正流程：每帧计算映射表 + clone + remap
+ *
+ */
+Mat imageCorrectionLegacy(Mat &image, Mat &cameraMatrix, Mat &distCoeffs) {
+  Size sizeImage(image.cols, image.rows);
+  Mat mapx = Mat(sizeImage, CV_32FC1);
+  Mat mapy = Mat(sizeImage, CV_32FC1);
+  Mat rotMatrix = Mat::eye(3, 3, CV_32F);
+  initUndistortRectifyMap(cameraMatrix, distCoeffs, rotMatrix, cameraMatrix,
+                          sizeImage, CV_32FC1, mapx, mapy);
+  Mat imageCorrect = image.clone();
+  remap(image, imageCorrect, mapx, mapy, INTER_LINEAR);
+  return imageCorrect;
+}
+
+/**
+ * @brief 单帧耗时统计
+ *
+ */
+struct Latency {
+  double sum = 0;
+  double min = 1e9;
+  double max = 0;
+  int counter = 0;
+
+  void add(double ms) {
+    sum += ms;
+    min = std::min(min, ms);
+    max = std::max(max, ms);
+    counter++;
+  }
+
+  void print(string name) {
+    cout << name << " : avg = " << sum / counter << "ms | min = " << min
+         << "ms | max = " << max << "ms" << endl;
+  }
+};
+
+int main(int argc, char *argv[]) {
+  int loops = 100; // 每张图像的循环次数
+  if (argc > 1)
+    loops = atoi(argv[1]);
+
+  Mat cameraMatrix, distCoeffs;
+  FileStorage file;
+  if (!file.open("../res/calibration/valid/calibration.xml",
+                 FileStorage::READ)) {
+    cout << "打开相机矫正参数失败!!!" << endl;
+    return -1;
+  }
+  file["cameraMatrix"] >> cameraMatrix;
+  file["distCoeffs"] >> distCoeffs;
+
+  vector<Mat> images;
+  vector<String> imagesPath;
+  glob("../res/calibration/corners/", imagesPath, false);
+  for (int i = 0; i < imagesPath.size(); i++) {
+    Mat image = imread(imagesPath[i]);
+    if (!image.empty())
+      images.push_back(image);
+  }
+  if (images.empty()) {
+    cout << "Error: no image in ../res/calibration/corners/" << endl;
+    return -1;
+  }
+  cout << "images: " << images.size() << " | loops: " << loops << endl;
+
+  ImagePreprocess imagePreprocess;
+  imagePreprocess.imageCorrecteInit();
+  ImagePreprocess imagePreprocessRows;
+  imagePreprocessRows.imageCorrecteInit();
+  imagePreprocessRows.imageCorrectionRows(20, 10); // motion.json默认切行
+
+  Latency legacy, cached, cachedRows;
+  double diffMax = 0; // 新旧矫正结果的最大像素差
+  for (int n = 0; n < loops; n++) {
+    for (int i = 0; i < images.size(); i++) {
+      auto start = chrono::steady_clock::now();
+      Mat imageLegacy =
+          imageCorrectionLegacy(images[i], cameraMatrix, distCoeffs);
+      auto mid = chrono::steady_clock::now();
+      Mat imageCached = imagePreprocess.imageCorrection(images[i]);
+      auto end = chrono::steady_clock::now();
+      imagePreprocessRows.imageCorrection(images[i]);
+      auto endRows = chrono::steady_clock::now();
+
+      legacy.add(chrono::duration<double, milli>(mid - start).count());
+      cached.add(chrono::duration<double, milli>(end - mid).count());
+      cachedRows.add(chrono::duration<double, milli>(endRows - end).count());
+
+      if (n == 0)
+        diffMax = max(diffMax, norm(imageLegacy, imageCached, NORM_INF));
+    }
+  }
+
+  legacy.print("[legacy] initUndistortRectifyMap + remap");
+  cached.print("[cached] CV_16SC2 maps + remap       ");
+  cachedRows.print("[rows]   CV_16SC2 maps + row cut     ");
+  cout << "speedup: " << legacy.sum / cached.sum
+       << "x | max pixel diff: " << diffMax << endl;
+
+  return 0;
+}
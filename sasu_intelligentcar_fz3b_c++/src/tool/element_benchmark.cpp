@@ -0,0 +1,162 @@
+/**
+ * @file element_benchmark.cpp
+ * @author lse
+ * @brief 赛道元素检测：基础赛道下AI标志类元素串行与线程池并行执行的耗时及结果一致性对比
+ * @version 0.1
+ * @date 2023-07-20
+ * @note 在build目录下运行：./element_benchmark [视频路径|图像文件夹|运行日志] [AI结果文件] [并行线程数] [附加检测数]
+ *       默认使用../res/regression/track/，无AI结果文件（"-"），4线程，每帧附加16个检测目标
+ *       附加检测目标：按固定随机种子在每帧中加入农田/维修厂/粮仓/桥/慢行区的标志及锥桶，模拟检测密集的帧
+ *       农田/维修厂/粮仓/桥/慢行区均使能，两条流水线逐帧输入相同数据，输出不一致时返回非0
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include "../include/common.hpp"
+#include "../include/frame_source.hpp"
+#include "../include/recorded_backend.hpp"
+#include "../src/icar_pipeline.cpp"
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <opencv2/opencv.hpp>
+
+using namespace std;
+using namespace cv;
+
+/**
+ * @brief 流水线初始化：AI标志类元素全部使能，不显示、不存图
+ *
+ */
+void pipelineInit(IcarPipeline &pipeline, int threads) {
+  pipeline.motionController.loadParams();
+  MotionController::Params &params = pipeline.motionController.params;
+  params.debug = false;
+  params.saveImage = false;
+  params.FarmlandEnable = true;
+  params.DepotEnable = true;
+  params.GranaryEnable = true;
+  params.BridgeEnable = true;
+  params.SlowzoneEnable = true;
+  params.elementThreads = threads;
+  pipeline.init();
+  pipeline.start(0);
+}
+
+/**
+ * @brief 附加检测目标：标志类别随机，位置/尺寸随机（固定种子，结果可复现）
+ *
+ */
+void appendDetections(vector<PredictResult> &predicts, int count, RNG &rng) {
+  const LabelId labels[] = {LABEL_CORN,   LABEL_TRACTOR, LABEL_GRANARY,
+                            LABEL_BRIDGE, LABEL_PIG,     LABEL_BUMP,
+                            LABEL_CONE,   LABEL_CONE};
+  for (int i = 0; i < count; i++) {
+    PredictResult result;
+    result.type = labels[rng.uniform(0, 8)];
+    result.label = LABEL_NAMES[result.type];
+    result.score = 0.9;
+    result.width = rng.uniform(10, 40);
+    result.height = rng.uniform(10, 40);
+    result.x = rng.uniform(0, COLSIMAGE - result.width);
+    result.y = rng.uniform(0, ROWSIMAGE - result.height);
+    predicts.push_back(result);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  string pathFrames = "../res/regression/track/";
+  string pathPredicts = "-";
+  int threads = 4;
+  int extra = 16;
+  if (argc > 1)
+    pathFrames = argv[1];
+  if (argc > 2)
+    pathPredicts = argv[2];
+  if (argc > 3)
+    threads = atoi(argv[3]);
+  if (argc > 4)
+    extra = atoi(argv[4]);
+
+  vector<Mat> frames;
+  FrameSource::load(pathFrames, frames);
+  for (Mat &frame : frames)
+    resize(frame, frame, Size(COLSIMAGE, ROWSIMAGE));
+  if (frames.empty()) {
+    cout << "Error: no frame in " << pathFrames << endl;
+    return -1;
+  }
+  map<int, vector<PredictResult>> predicts;
+  if (pathPredicts != "-")
+    RecordedBackend::load(pathPredicts, predicts);
+
+  IcarPipeline serial, parallel;
+  pipelineInit(serial, 1);
+  pipelineInit(parallel, threads);
+
+  RNG rng(0x1CA2);
+  double timeSerial = 0, timeParallel = 0;
+  double timeSerialDense = 0, timeParallelDense = 0; // 检测目标不少于8个的帧
+  int counter = 0, counterDense = 0, mismatches = 0;
+  vector<PredictResult> input, inputSerial, inputParallel;
+  for (; counter < frames.size(); counter++) {
+    input.clear();
+    auto it = predicts.find(counter);
+    if (it != predicts.end())
+      input = it->second;
+    appendDetections(input, extra, rng);
+    inputSerial = input; // 元素识别可能改写检测结果
+    inputParallel = input;
+    double time = counter * 1000.0 / 30;
+
+    auto t0 = chrono::steady_clock::now();
+    serial.process(frames[counter], inputSerial, time);
+    auto t1 = chrono::steady_clock::now();
+    parallel.process(frames[counter], inputParallel, time);
+    auto t2 = chrono::steady_clock::now();
+    double msSerial = chrono::duration<double, milli>(t1 - t0).count();
+    double msParallel = chrono::duration<double, milli>(t2 - t1).count();
+    timeSerial += msSerial;
+    timeParallel += msParallel;
+    if (input.size() >= 8) {
+      timeSerialDense += msSerial;
+      timeParallelDense += msParallel;
+      counterDense++;
+    }
+
+    if (serial.roadType != parallel.roadType ||
+        serial.controlCenterCal.controlCenter !=
+            parallel.controlCenterCal.controlCenter ||
+        serial.motionController.servoPwm !=
+            parallel.motionController.servoPwm ||
+        serial.finish != parallel.finish) {
+      if (mismatches++ == 0)
+        cout << "Error: output mismatch at frame [" << counter << "]" << endl;
+    }
+    if (serial.finish || parallel.finish) {
+      counter++;
+      break;
+    }
+  }
+
+  cout << "frames: " << counter << " [" << pathFrames << "], dense frames: "
+       << counterDense << ", threads: " << threads << endl;
+  cout << "[serial]   " << timeSerial / counter << "ms/frame";
+  if (counterDense)
+    cout << ", dense " << timeSerialDense / counterDense << "ms/frame";
+  cout << endl;
+  cout << "[parallel] " << timeParallel / counter << "ms/frame";
+  if (counterDense)
+    cout << ", dense " << timeParallelDense / counterDense << "ms/frame";
+  cout << endl;
+  cout << "saving: " << (timeSerial - timeParallel) / counter << "ms/frame";
+  if (counterDense)
+    cout << ", dense " << (timeSerialDense - timeParallelDense) / counterDense
+         << "ms/frame";
+  cout << endl;
+  cout << "[serial] elements:" << endl;
+  serial.printElementTiming();
+  cout << "[parallel] elements:" << endl;
+  parallel.printElementTiming();
+  cout << "output mismatches: " << mismatches << endl;
+  return mismatches ? 1 : 0;
+}
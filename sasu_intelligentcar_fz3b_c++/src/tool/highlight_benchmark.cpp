@@ -0,0 +1,160 @@
+/**
+ * @file highlight_benchmark.cpp
+ * @author lse
+ * @brief 高光抑制：浮点pow实现（旧）与8bit查表实现（新）的结果校验及耗时对比
+ * @version 0.1
+ * @date 2023-07-20
+ * @note 在build目录下运行：./highlight_benchmark [循环次数]
+ *       新旧结果的像素差超过容差时返回非0
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include "../include/common.hpp"
+#include "../src/image_preprocess.cpp"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <opencv2/highgui.hpp>
+#include <opencv2/opencv.hpp>
+
+using namespace std;
+using namespace cv;
+
+#define TOLERANCE_MAX 3    // 单像素最大误差
+#define TOLERANCE_MEAN 0.5 // 平均误差
+
+/**
+ * @brief 旧版高光抑制（逐像素浮点pow），作为基准结果
+ *
+ */
+cv::Mat HighLight(cv::Mat input, int light) {
+  // 生成灰度图
+  cv::Mat gray = cv::Mat::zeros(input.size(), CV_32FC1);
+  cv::Mat f = input.clone();
+  f.convertTo(f, CV_32FC3);
+  vector<cv::Mat> pics;
+  split(f, pics);
+  gray = 0.299f * pics[2] + 0.587 * pics[1] + 0.114 * pics[0];
+  gray = gray / 255.f;
+
+  // 确定高光区
+  cv::Mat thresh = cv::Mat::zeros(gray.size(), gray.type());
+  thresh = gray.mul(gray);
+  // 取平均值作为阈值
+  Scalar t = mean(thresh);
+  cv::Mat mask = cv::Mat::zeros(gray.size(), CV_8UC1);
+  mask.setTo(255, thresh >= t[0]);
+
+  // 参数设置
+  int max = 4;
+  float bright = light / 100.0f / max;
+  float mid = 1.0f + max * bright;
+
+  // 边缘平滑过渡
+  cv::Mat midrate = cv::Mat::zeros(input.size(), CV_32FC1);
+  cv::Mat brightrate = cv::Mat::zeros(input.size(), CV_32FC1);
+  for (int i = 0; i < input.rows; ++i) {
+    uchar *m = mask.ptr<uchar>(i);
+    float *th = thresh.ptr<float>(i);
+    float *mi = midrate.ptr<float>(i);
+    float *br = brightrate.ptr<float>(i);
+    for (int j = 0; j < input.cols; ++j) {
+      if (m[j] == 255) {
+        mi[j] = mid;
+        br[j] = bright;
+      } else {
+        mi[j] = (mid - 1.0f) / t[0] * th[j] + 1.0f;
+        br[j] = (1.0f / t[0] * th[j]) * bright;
+      }
+    }
+  }
+
+  // 高光提亮，获取结果图
+  cv::Mat result = cv::Mat::zeros(input.size(), input.type());
+  for (int i = 0; i < input.rows; ++i) {
+    float *mi = midrate.ptr<float>(i);
+    float *br = brightrate.ptr<float>(i);
+    uchar *in = input.ptr<uchar>(i);
+    uchar *r = result.ptr<uchar>(i);
+    for (int j = 0; j < input.cols; ++j) {
+      for (int k = 0; k < 3; ++k) {
+        float temp = pow(float(in[3 * j + k]) / 255.f, 1.0f / mi[j]) *
+                     (1.0 / (1 - br[j]));
+        if (temp > 1.0f)
+          temp = 1.0f;
+        if (temp < 0.0f)
+          temp = 0.0f;
+        uchar utemp = uchar(255 * temp);
+        r[3 * j + k] = utemp;
+      }
+    }
+  }
+  return result;
+}
+
+int main(int argc, char *argv[]) {
+  int loops = 20; // 每张图像的循环次数
+  if (argc > 1)
+    loops = atoi(argv[1]);
+  int light = -50; // 与icar一致
+
+  vector<Mat> images;
+  vector<String> imagesPath;
+  glob("../res/calibration/corners/", imagesPath, false);
+  for (int i = 0; i < imagesPath.size(); i++) {
+    Mat image = imread(imagesPath[i]);
+    if (!image.empty())
+      images.push_back(image);
+  }
+  if (images.empty()) {
+    cout << "Error: no image in ../res/calibration/corners/" << endl;
+    return -1;
+  }
+
+  ImagePreprocess imagePreprocess;
+
+  //[1] 结果校验：以旧版实现为基准
+  double diffMax = 0, diffMean = 0, binaryDiff = 0;
+  for (int i = 0; i < images.size(); i++) {
+    Mat golden = HighLight(images[i], light);
+    Mat result = imagePreprocess.imageHighLight(images[i], light).clone();
+
+    Mat diff;
+    absdiff(golden, result, diff);
+    diffMax = max(diffMax, norm(diff, NORM_INF));
+    Scalar diffChannels = mean(diff);
+    diffMean += (diffChannels[0] + diffChannels[1] + diffChannels[2]) / 3 /
+                images.size();
+
+    Mat goldenBinary = imagePreprocess.imageBinaryzation(golden);
+    Mat resultBinary = imagePreprocess.imageBinaryzation(result);
+    binaryDiff += (double)countNonZero(goldenBinary != resultBinary) /
+                  goldenBinary.total() / images.size();
+  }
+  cout << "max pixel diff: " << diffMax << " | mean pixel diff: " << diffMean
+       << " | binary mismatch: " << binaryDiff * 100 << "%" << endl;
+
+  //[2] 耗时对比
+  double timeLegacy = 0, timeLut = 0;
+  for (int n = 0; n < loops; n++) {
+    for (int i = 0; i < images.size(); i++) {
+      auto start = chrono::steady_clock::now();
+      HighLight(images[i], light);
+      auto mid = chrono::steady_clock::now();
+      imagePreprocess.imageHighLight(images[i], light);
+      auto end = chrono::steady_clock::now();
+      timeLegacy += chrono::duration<double, milli>(mid - start).count();
+      timeLut += chrono::duration<double, milli>(end - mid).count();
+    }
+  }
+  int frames = loops * images.size();
+  cout << "[legacy] float pow : " << timeLegacy / frames << "ms/frame" << endl;
+  cout << "[lut]    8bit table: " << timeLut / frames << "ms/frame" << endl;
+  cout << "speedup: " << timeLegacy / timeLut << "x" << endl;
+
+  if (diffMax > TOLERANCE_MAX || diffMean > TOLERANCE_MEAN) {
+    cout << "Error: HighLight result out of tolerance!!!" << endl;
+    return 1;
+  }
+  return 0;
+}
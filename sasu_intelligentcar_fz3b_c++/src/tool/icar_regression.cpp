@@ -0,0 +1,195 @@
+/**
+ * @file icar_regression.cpp
+ * @author lse
+ * @brief 回归检查：录制序列驱动完整识别与控制流程，逐帧输出与标准输出比较
+ * @version 0.1
+ * @date 2023-07-28
+ * @note 在build目录下运行：./icar_regression [视频路径|图像文件夹|运行日志] [AI结果文件] [标准输出] [控制中心容差] [舵机容差] [帧率容差] [update]
+ *       默认使用../res/regression/下的录制序列（track/）、AI结果（track.txt）与标准输出（track.csv）
+ *       赛道类型须一致，控制中心/舵机PWM偏差不超过容差（默认2/10）；标准输出不存在时失败
+ *       帧率取多轮回放（3轮）中最快的一轮，只计流程处理时间；低于标准输出记录的基准帧率 * (1 - 帧率容差)时失败
+ *       （默认0.3，0：不检查）；基准帧率与机器相关，需在目标平台上update记录
+ *       update：只记录本次结果与帧率为标准输出（有意修改识别/控制参数后更新，检查差异后提交）
+ *       ctest运行：cmake .. && make && ctest
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include "../include/common.hpp"
+#include "../include/frame_replay.hpp"
+#include "../include/recorded_backend.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <opencv2/opencv.hpp>
+#include <sstream>
+
+using namespace std;
+using namespace cv;
+
+/**
+ * @brief 回放一轮
+ *
+ * @return double 流程处理总耗时（ms），-1：无法读取
+ */
+double regressionRun(string pathFrames, map<int, vector<PredictResult>> &predicts,
+                     vector<FrameOutput> &outputs) {
+  FrameSource source;
+  if (!source.open(pathFrames))
+    return -1;
+  IcarPipeline pipeline;
+  replayInit(pipeline);
+  return replayRun(source, pipeline, predicts, 30, outputs);
+}
+
+/**
+ * @brief 读取标准输出
+ *
+ * @param fps 输出：基准帧率（0：未记录）
+ */
+bool goldenLoad(string path, vector<FrameOutput> &outputs, double &fps) {
+  ifstream file(path);
+  if (!file.is_open())
+    return false;
+  string line;
+  while (getline(file, line)) {
+    if (line.rfind("# fps", 0) == 0) { // "# fps <帧率>"
+      fps = atof(line.c_str() + 5);
+      continue;
+    }
+    if (line.empty() || line[0] == 'f' || line[0] == '#') // 表头/注释
+      continue;
+    replace(line.begin(), line.end(), ',', ' ');
+    istringstream stream(line);
+    int frame;
+    FrameOutput output;
+    stream >> frame >> output.roadType >> output.controlCenter >>
+        output.servoPwm >> output.motorSpeed >> output.controlSpeed;
+    outputs.push_back(output);
+  }
+  return true;
+}
+
+bool goldenSave(string path, vector<FrameOutput> &outputs, double fps) {
+  ofstream file(path);
+  if (!file.is_open())
+    return false;
+  file << "# fps " << fps << endl;
+  file << FrameOutput::header() << endl;
+  for (int i = 0; i < outputs.size(); i++)
+    outputs[i].write(file, i);
+  return file.good();
+}
+
+int main(int argc, char *argv[]) {
+  string pathFrames = "../res/regression/track/";
+  string pathPredicts = "../res/regression/track.txt";
+  string pathGolden = "../res/regression/track.csv";
+  int toleranceCenter = 2;
+  int tolerancePwm = 10;
+  double toleranceFps = 0.3;
+  bool update = false;
+  int rounds = 3;
+  vector<string> args;
+  for (int i = 1; i < argc; i++) {
+    if (string(argv[i]) == "update")
+      update = true;
+    else
+      args.push_back(argv[i]);
+  }
+  if (args.size() > 0) { // 指定序列：默认无AI结果，标准输出需指定
+    pathFrames = args[0];
+    pathPredicts = "-";
+    pathGolden = "";
+  }
+  if (args.size() > 1)
+    pathPredicts = args[1];
+  if (args.size() > 2)
+    pathGolden = args[2];
+  if (args.size() > 3)
+    toleranceCenter = atoi(args[3].c_str());
+  if (args.size() > 4)
+    tolerancePwm = atoi(args[4].c_str());
+  if (args.size() > 5)
+    toleranceFps = atof(args[5].c_str());
+  if (pathGolden.empty()) {
+    cout << "Error: golden output path required for " << pathFrames << endl;
+    return -1;
+  }
+
+  map<int, vector<PredictResult>> predicts;
+  if (pathPredicts != "-" && !RecordedBackend::load(pathPredicts, predicts)) {
+    cout << "Error: detections not found: " << pathPredicts << endl;
+    return -1;
+  }
+
+  //[1] 回放：首轮输出用于比较，帧率取多轮中最快的一轮
+  vector<FrameOutput> outputs, repeat;
+  double timeProcess = regressionRun(pathFrames, predicts, outputs);
+  if (timeProcess < 0 || outputs.empty()) {
+    cout << "Error: no frame in " << pathFrames << endl;
+    return -1;
+  }
+  cout << "frames: " << outputs.size() << " [" << pathFrames << "]" << endl;
+  if (update || toleranceFps > 0) {
+    for (int n = 1; n < rounds; n++)
+      timeProcess = min(timeProcess, regressionRun(pathFrames, predicts, repeat));
+  }
+  double fps = outputs.size() * 1000.0 / max(timeProcess, 1e-3);
+
+  //[2] 记录标准输出：仅update
+  if (update) {
+    if (!goldenSave(pathGolden, outputs, fps)) {
+      cout << "Error: golden write failed: " << pathGolden << endl;
+      return -1;
+    }
+    cout << "golden recorded -> " << pathGolden << " (" << fps << "fps)"
+         << endl;
+    return 0;
+  }
+  vector<FrameOutput> golden;
+  double fpsGolden = 0;
+  if (!goldenLoad(pathGolden, golden, fpsGolden)) {
+    cout << "Error: golden not found: " << pathGolden
+         << " (record with: ./icar_regression ... update)" << endl;
+    return 1;
+  }
+
+  //[3] 逐帧比较
+  int mismatches = 0;
+  if (golden.size() != outputs.size()) {
+    cout << "Error: frames " << outputs.size() << " != golden "
+         << golden.size() << endl;
+    mismatches++;
+  }
+  for (int i = 0; i < min(golden.size(), outputs.size()); i++) {
+    FrameOutput &a = outputs[i], &b = golden[i];
+    if (a.roadType == b.roadType &&
+        abs(a.controlCenter - b.controlCenter) <= toleranceCenter &&
+        abs(a.servoPwm - b.servoPwm) <= tolerancePwm)
+      continue;
+    if (mismatches++ < 10)
+      cout << "Error: frame [" << i << "] roadType " << a.roadType << "/"
+           << b.roadType << " controlCenter " << a.controlCenter << "/"
+           << b.controlCenter << " servoPwm " << a.servoPwm << "/"
+           << b.servoPwm << " (output/golden)" << endl;
+  }
+  cout << "mismatch frames: " << mismatches << "/" << outputs.size() << endl;
+
+  //[4] 帧率检查：相对标准输出记录的基准帧率
+  bool slow = false;
+  if (toleranceFps > 0) {
+    if (fpsGolden <= 0) {
+      cout << "Error: no baseline fps in " << pathGolden
+           << " (record with: ./icar_regression ... update)" << endl;
+      slow = true;
+    } else {
+      double fpsMin = fpsGolden * (1 - toleranceFps);
+      slow = fps < fpsMin;
+      cout << "fps: " << fps << " golden: " << fpsGolden << " (min " << fpsMin
+           << ")" << (slow ? " SLOW" : "") << endl;
+    }
+  }
+
+  return (mismatches || slow) ? 1 : 0;
+}
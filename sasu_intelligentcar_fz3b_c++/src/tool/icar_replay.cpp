@@ -0,0 +1,87 @@
+/**
+ * @file icar_replay.cpp
+ * @author lse
+ * @brief 离线回放：录制帧（及AI检测结果）按帧驱动icar完整识别与控制流程
+ * @version 0.1
+ * @date 2023-07-20
+ * @note 在build目录下运行：./icar_replay [视频路径|图像文件夹|运行日志] [AI结果文件] [输出文件] [帧率]
+ *       默认使用../res/regression/track/，输出./replay.csv，帧率30
+ *       AI结果文件（可选，"-"表示无）：每行一个目标 "帧序号 type label score x y width height"
+ *       运行日志（.runlog）：帧、AI结果与帧时间均取自日志，并与日志中的控制输出逐帧比较
+ *       不依赖串口与FPGA，计时器按帧率推算的帧时间驱动，相同输入的输出完全一致
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include "../include/common.hpp"
+#include "../include/frame_replay.hpp"
+#include "../include/recorded_backend.hpp"
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <opencv2/opencv.hpp>
+#include <sstream>
+
+using namespace std;
+using namespace cv;
+
+int main(int argc, char *argv[]) {
+  string pathFrames = "../res/regression/track/";
+  string pathPredicts = "-";
+  string pathOutput = "./replay.csv";
+  double fps = 30;
+  if (argc > 1)
+    pathFrames = argv[1];
+  if (argc > 2)
+    pathPredicts = argv[2];
+  if (argc > 3)
+    pathOutput = argv[3];
+  if (argc > 4)
+    fps = atof(argv[4]);
+
+  FrameSource source;
+  if (!source.open(pathFrames)) {
+    cout << "Error: no frame in " << pathFrames << endl;
+    return -1;
+  }
+  map<int, vector<PredictResult>> predicts;
+  if (pathPredicts != "-")
+    RecordedBackend::load(pathPredicts, predicts);
+
+  IcarPipeline pipeline;
+  replayInit(pipeline);
+  Profiler::enable(pipeline.motionController.params.profileEnable);
+  Profiler::enableCounters(pipeline.motionController.params.profileCounters);
+
+  ofstream output(pathOutput);
+  output << FrameOutput::header() << endl;
+
+  vector<FrameOutput> outputs;
+  int mismatches = 0; // 与运行日志中控制输出不一致的帧数
+  double timeProcess =
+      replayRun(source, pipeline, predicts, fps, outputs, [&](int counter) {
+        outputs.back().write(output, counter);
+        if (source.isRunLog() &&
+            (pipeline.roadType != source.record.roadType ||
+             pipeline.motionController.servoPwm != source.record.servoPwm)) {
+          if (mismatches++ == 0)
+            cout << "Warning: output differs from run log at frame ["
+                 << counter << "]" << endl;
+        }
+      });
+  int counter = outputs.size();
+  if (pipeline.finish) // 入库完成/冲出赛道
+    cout << "Replay finished at frame [" << counter - 1 << "]" << endl;
+
+  cout << "frames: " << counter << " [" << pathFrames << "] -> " << pathOutput
+       << endl;
+  if (counter > 0)
+    cout << "pipeline: " << timeProcess / counter << "ms/frame, "
+         << counter * 1000.0 / timeProcess << "fps" << endl;
+  pipeline.printElementTiming(); // 赛道元素处理耗时：执行/跳过次数
+  Profiler::instance().report();  // 分阶段耗时百分位
+  if (pipeline.motionController.params.profileTrace)
+    Profiler::instance().writeTrace(pathOutput + ".trace.json"); // 阶段时间线
+  if (source.isRunLog())
+    cout << "run log output mismatches: " << mismatches << endl;
+  return 0;
+}
@@ -1,40 +1,105 @@
-
+/**
+ * @file image2video.cpp
+ * @brief 合成视频：运行日志（.runlog）或编号图片（../res/samples/train/N.jpg）转视频
+ * @note 在build目录下运行：./image2video [运行日志|图片文件夹] [输出视频] [帧率] [叠加识别结果]
+ *       默认将../res/samples/train/下的编号图片合成../res/samples/video.mp4，帧率20
+ *       运行日志：顺序读取映射的记录，叠加识别结果（1）时绘制赛道边缘/AI目标/赛道类型/舵机PWM
+ */
 #include <fstream>
 #include <iostream>
 #include <opencv2/highgui.hpp>
 #include <opencv2/opencv.hpp>
 #include "../include/common.hpp"
+#include "../include/run_log.hpp"
 
 using namespace std;
 using namespace cv;
 
-int main()
+/**
+ * @brief 运行日志单帧叠加识别结果
+ *
+ */
+void drawRecord(Mat &image, RunLogFrame &record)
 {
-    VideoWriter writer;
+    for (int i = 0; i < record.edgeLeft.size(); i++)
+        circle(image, Point(record.edgeLeft[i].y, record.edgeLeft[i].x), 1, Scalar(0, 255, 0), -1);
+    for (int i = 0; i < record.edgeRight.size(); i++)
+        circle(image, Point(record.edgeRight[i].y, record.edgeRight[i].x), 1, Scalar(0, 255, 255), -1);
+    for (int i = 0; i < record.predicts.size(); i++)
+    {
+        PredictResult &result = record.predicts[i];
+        rectangle(image, Rect(result.x, result.y, result.width, result.height), Scalar(0, 0, 255), 1);
+        putText(image, result.label, Point(result.x, result.y - 2), FONT_HERSHEY_PLAIN, 0.8, Scalar(0, 0, 255), 1);
+    }
+    putText(image, "[" + to_string(record.roadType) + "] pwm: " + to_string(record.servoPwm),
+            Point(10, 20), FONT_HERSHEY_TRIPLEX, 0.4, Scalar(0, 0, 255), 1);
+}
+
+int main(int argc, char *argv[])
+{
+    string pathInput = "../res/samples/train/";
+    string pathVideo = "../res/samples/video.mp4";
     int frame_fps = 20;
+    bool overlay = false;
+    if (argc > 1)
+        pathInput = argv[1];
+    if (argc > 2)
+        pathVideo = argv[2];
+    if (argc > 3)
+        frame_fps = atoi(argv[3]);
+    if (argc > 4)
+        overlay = atoi(argv[4]);
+
+    VideoWriter writer;
     int frame_width = 320;
     int frame_height = 240;
 
-    writer = VideoWriter("../res/samples/video.mp4", CV_FOURCC('P', 'I', 'M', '1'),
+    writer = VideoWriter(pathVideo, CV_FOURCC('P', 'I', 'M', '1'),
                          frame_fps, Size(frame_width, frame_height), true);
     cout << "frame_width is " << frame_width << endl;
     cout << "frame_height is " << frame_height << endl;
     cout << "frame_fps is " << frame_fps << endl;
 
     Mat img;
-    for (int i = 1; i < 5000; i++)
+    int counter = 0;
+    if (RunLogReader::isRunLog(pathInput)) // 运行日志
     {
-        string image_name = "../res/samples/train/" + to_string(i) + ".jpg";
-
-        img = imread(image_name);
-        if (!img.empty())
+        RunLogReader log;
+        RunLogFrame record;
+        if (!log.open(pathInput))
+            return -1;
+        for (int i = 0; i < log.size(); i++)
         {
+            log.read(i, record);
+            if (record.image.channels() == 2) // YUYV
+                cvtColor(record.image, img, COLOR_YUV2BGR_YUYV);
+            else if (record.image.channels() == 1)
+                cvtColor(record.image, img, COLOR_GRAY2BGR);
+            else
+                record.image.copyTo(img);
+            if (img.cols != frame_width || img.rows != frame_height)
+                resize(img, img, Size(frame_width, frame_height));
+            if (overlay)
+                drawRecord(img, record);
             writer << img;
+            counter++;
+        }
+    }
+    else // 编号图片
+    {
+        for (int i = 1; i < 5000; i++)
+        {
+            string image_name = pathInput + to_string(i) + ".jpg";
+
+            img = imread(image_name);
+            if (!img.empty())
+            {
+                writer << img;
+                counter++;
+            }
         }
-        // else
-        //     break;
     }
 
-    waitKey(0);
+    cout << "frames: " << counter << " -> " << pathVideo << endl;
     return 0;
 }
@@ -0,0 +1,100 @@
+/**
+ * @file inference_benchmark.cpp
+ * @author lse
+ * @brief AI推理：各推理后端（Paddle Lite FPGA / OpenCV DNN / 录制回放）的单帧耗时及检测结果对比
+ * @version 0.1
+ * @date 2023-07-20
+ * @note 在build目录下运行：./inference_benchmark [视频路径|图像文件夹|运行日志] [模型路径] [后端列表]
+ *       默认使用../res/regression/track/、../res/model/mobilenet-ssd，后端列表如 "paddle,opencv"
+ *       （默认：编译Paddle Lite时为paddle,opencv，否则为opencv）
+ *       可选输出录制文件：设置环境变量 RECORD=路径，按首个后端的结果写入，供recorded后端/icar_replay使用
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include "../include/common.hpp"
+#include "../include/frame_source.hpp"
+#include "../include/predictor.hpp"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <opencv2/opencv.hpp>
+#include <sstream>
+
+using namespace std;
+using namespace cv;
+
+int main(int argc, char *argv[]) {
+  string pathFrames = "../res/regression/track/";
+  string pathModel = "../res/model/mobilenet-ssd";
+#ifdef PADDLE_LITE_ENABLE
+  string backends = "paddle,opencv";
+#else
+  string backends = "opencv";
+#endif
+  if (argc > 1)
+    pathFrames = argv[1];
+  if (argc > 2)
+    pathModel = argv[2];
+  if (argc > 3)
+    backends = argv[3];
+
+  vector<Mat> frames;
+  FrameSource::load(pathFrames, frames);
+  if (frames.empty()) {
+    cout << "Error: no frame in " << pathFrames << endl;
+    return -1;
+  }
+  for (int i = 0; i < frames.size(); i++)
+    resize(frames[i], frames[i], Size(COLSIMAGE, ROWSIMAGE));
+  cout << "frames: " << frames.size() << " [" << pathFrames << "]" << endl;
+
+  const char *pathRecord = getenv("RECORD");
+  vector<size_t> detectionsFirst; // 首个后端每帧的检测数量
+  int errors = 0;
+  stringstream list(backends);
+  string backend;
+  while (getline(list, backend, ',')) {
+    Predictor predictor(pathModel, backend);
+    if (predictor.init() != 0) {
+      cout << "Error: backend [" << backend << "] init failed!" << endl;
+      errors++;
+      continue;
+    }
+    predictor.run(frames[0], 1); // 首帧包含启动耗时，不计入
+
+    ofstream record;
+    if (pathRecord && detectionsFirst.empty())
+      record.open(pathRecord);
+
+    vector<size_t> detections;
+    size_t total = 0;
+    double timeRun = 0, timeMax = 0;
+    for (int i = 0; i < frames.size(); i++) {
+      auto start = chrono::steady_clock::now();
+      vector<PredictResult> results = predictor.run(frames[i], i + 1);
+      double time = chrono::duration<double, milli>(
+                        chrono::steady_clock::now() - start)
+                        .count();
+      timeRun += time;
+      timeMax = max(timeMax, time);
+      detections.push_back(results.size());
+      total += results.size();
+      if (record.is_open())
+        RecordedBackend::save(record, i, results);
+    }
+
+    int mismatch = 0;
+    if (detectionsFirst.empty())
+      detectionsFirst = detections;
+    else {
+      for (int i = 0; i < detections.size(); i++)
+        mismatch += detections[i] != detectionsFirst[i];
+    }
+    cout << "[" << predictor.backendName() << "] mean: "
+         << timeRun / frames.size() << "ms max: " << timeMax
+         << "ms, detections: " << total
+         << ", frames differing from first backend: " << mismatch << endl;
+  }
+
+  return errors ? 1 : 0;
+}
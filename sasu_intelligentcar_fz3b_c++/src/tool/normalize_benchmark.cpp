@@ -0,0 +1,178 @@
+/**
+ * @file normalize_benchmark.cpp
+ * @author lse
+ * @brief AI输入预处理：OpenCV分步实现（缩放/通道交换/归一化/打包）与融合内核的结果校验及耗时对比
+ * @version 0.1
+ * @date 2023-07-20
+ * @note 在build目录下运行：./normalize_benchmark [视频路径|图像文件夹|运行日志] [模型路径] [循环次数]
+ *       默认使用../res/regression/track/、../res/model/mobilenet-ssd（读取config.json的尺寸/均值/缩放/通道顺序）
+ *       融合内核与分步实现的误差超过1个灰度级 * scale时返回非0
+ *       编译Paddle Lite时同时与Paddle图像预处理库（现有预处理）的输出对比，误差超过1个灰度级或无法初始化时返回非0
+ *       通过后才可在config.json中开启fused_preprocess
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include "../include/common.hpp"
+#include "../include/frame_source.hpp"
+#include "../include/model_config.hpp"
+#include "../include/resize_normalize.hpp"
+#ifdef PADDLE_LITE_ENABLE
+#include "../include/paddle_backend.hpp"
+#endif
+#include <chrono>
+#include <iostream>
+#include <opencv2/dnn.hpp>
+#include <opencv2/opencv.hpp>
+
+using namespace std;
+using namespace cv;
+
+/**
+ * @brief 分步实现（NHWC）：cv::resize -> cvtColor -> (x - mean) * scale
+ *
+ */
+void referenceNHWC(Mat &frame, ModelConfig &config, Mat &resized, Mat &output) {
+  resize(frame, resized, Size(config.input_width, config.input_height));
+  if (config.format == "RGB")
+    cvtColor(resized, resized, COLOR_BGR2RGB);
+  resized.convertTo(output, CV_32FC3);
+  output -= Scalar(config.means[0], config.means[1], config.means[2]);
+  multiply(output, Scalar(config.scales[0], config.scales[1], config.scales[2]),
+           output);
+}
+
+/**
+ * @brief 最大误差（灰度级）
+ *
+ */
+double maxError(const float *a, const float *b, size_t size, float scale) {
+  double error = 0;
+  for (size_t i = 0; i < size; i++)
+    error = max(error, (double)fabs(a[i] - b[i]));
+  return error / scale;
+}
+
+int main(int argc, char *argv[]) {
+  string pathFrames = "../res/regression/track/";
+  string pathModel = "../res/model/mobilenet-ssd";
+  int loops = 10;
+  if (argc > 1)
+    pathFrames = argv[1];
+  if (argc > 2)
+    pathModel = argv[2];
+  if (argc > 3)
+    loops = atoi(argv[3]);
+
+  vector<Mat> frames;
+  FrameSource::load(pathFrames, frames);
+  if (frames.empty()) {
+    cout << "Error: no frame in " << pathFrames << endl;
+    return -1;
+  }
+  for (int i = 0; i < frames.size(); i++)
+    resize(frames[i], frames[i], Size(COLSIMAGE, ROWSIMAGE));
+  cout << "frames: " << frames.size() << " [" << pathFrames << "]" << endl;
+
+  ModelConfig config(pathModel, "opencv"); // 不检查Paddle模型文件
+  bool swapRB = config.format == "RGB";
+  int width = config.input_width, height = config.input_height;
+  size_t size = 3 * width * height;
+  cout << "input: " << COLSIMAGE << "x" << ROWSIMAGE << " -> " << width << "x"
+       << height << " " << config.format << endl;
+
+  ResizeNormalize kernelNHWC, kernelNCHW;
+  kernelNHWC.init(width, height, config.means, config.scales, swapRB,
+                  ResizeNormalize::NHWC);
+  kernelNCHW.init(width, height, config.means, config.scales, swapRB,
+                  ResizeNormalize::NCHW);
+  vector<float> fusedNHWC(size), fusedNCHW(size);
+  Mat resized, referenceHWC, blob;
+
+  //[1] 结果校验（cv::resize输出取整为8位，允许1个灰度级误差）
+  double errorNHWC = 0, errorNCHW = 0;
+  for (int i = 0; i < frames.size(); i++) {
+    referenceNHWC(frames[i], config, resized, referenceHWC);
+    kernelNHWC.run(frames[i], fusedNHWC.data());
+    errorNHWC = max(errorNHWC, maxError(referenceHWC.ptr<float>(),
+                                        fusedNHWC.data(), size,
+                                        config.scales[0]));
+
+    dnn::blobFromImage(frames[i], blob, config.scales[0], Size(width, height),
+                       Scalar(config.means[0], config.means[1], config.means[2]),
+                       swapRB, false);
+    kernelNCHW.run(frames[i], fusedNCHW.data());
+    errorNCHW = max(errorNCHW, maxError(blob.ptr<float>(), fusedNCHW.data(),
+                                        size, config.scales[0]));
+  }
+  cout << "max error (gray levels): NHWC = " << errorNHWC
+       << ", NCHW = " << errorNCHW << endl;
+  int errors = (errorNHWC > 1.0 || errorNCHW > 1.0) ? 1 : 0;
+  if (errors)
+    cout << "Error: fused kernel mismatch!" << endl;
+
+#ifdef PADDLE_LITE_ENABLE
+  {
+    shared_ptr<ModelConfig> paddleConfig =
+        make_shared<ModelConfig>(pathModel, "paddle");
+    paddleConfig->fused_preprocess = false; // Paddle图像预处理库
+    PaddleBackend backend;
+    if (backend.init(paddleConfig) == 0) {
+      double errorPaddle = 0;
+      for (int i = 0; i < frames.size(); i++) {
+        backend.preprocess().run(frames[i], backend.input());
+        kernelNHWC.run(frames[i], fusedNHWC.data());
+        errorPaddle = max(errorPaddle,
+                          maxError(backend.input()->data<float>(),
+                                   fusedNHWC.data(), size, config.scales[0]));
+      }
+      cout << "max error vs Paddle preprocess (gray levels): " << errorPaddle
+           << endl;
+      if (errorPaddle > 1.0) {
+        cout << "Error: fused kernel mismatch against Paddle preprocess!"
+             << endl;
+        errors = 1;
+      }
+    } else {
+      cout << "Error: Paddle backend init failed, preprocess not compared!"
+           << endl;
+      errors = 1;
+    }
+  }
+#endif
+
+  //[2] 耗时对比
+  double timeReference = 0, timeBlob = 0, timeNHWC = 0, timeNCHW = 0;
+  for (int n = 0; n < loops; n++) {
+    for (int i = 0; i < frames.size(); i++) {
+      auto t0 = chrono::steady_clock::now();
+      referenceNHWC(frames[i], config, resized, referenceHWC);
+      auto t1 = chrono::steady_clock::now();
+      dnn::blobFromImage(frames[i], blob, config.scales[0], Size(width, height),
+                         Scalar(config.means[0], config.means[1],
+                                config.means[2]),
+                         swapRB, false);
+      auto t2 = chrono::steady_clock::now();
+      kernelNHWC.run(frames[i], fusedNHWC.data());
+      auto t3 = chrono::steady_clock::now();
+      kernelNCHW.run(frames[i], fusedNCHW.data());
+      auto t4 = chrono::steady_clock::now();
+      timeReference += chrono::duration<double, milli>(t1 - t0).count();
+      timeBlob += chrono::duration<double, milli>(t2 - t1).count();
+      timeNHWC += chrono::duration<double, milli>(t3 - t2).count();
+      timeNCHW += chrono::duration<double, milli>(t4 - t3).count();
+    }
+  }
+  int counter = loops * frames.size();
+  cout << "[opencv] resize/cvtColor/normalize NHWC: " << timeReference / counter
+       << "ms/frame" << endl;
+  cout << "[opencv] blobFromImage NCHW          : " << timeBlob / counter
+       << "ms/frame" << endl;
+  cout << "[fused]  NHWC                        : " << timeNHWC / counter
+       << "ms/frame" << endl;
+  cout << "[fused]  NCHW                        : " << timeNCHW / counter
+       << "ms/frame" << endl;
+  cout << "speedup: " << timeReference / timeNHWC << "x (NHWC), "
+       << timeBlob / timeNCHW << "x (NCHW)" << endl;
+
+  return errors;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file pipeline_benchmark.cpp
+ * @author lse
+ * @brief 分级流水线：预处理/识别控制两级分线程执行与串行处理的吞吐、端到端延迟及结果一致性对比
+ * @version 0.1
+ * @date 2023-07-24
+ * @note 在build目录下运行：./pipeline_benchmark [视频路径|图像文件夹|运行日志] [AI结果文件] [预处理核] [识别控制核]
+ *       默认使用../res/regression/track/，无AI结果文件（"-"），绑定核2/3（-1：不绑定）
+ *       依次测试串行及在途帧数1~3的流水线，逐帧比较输出，不一致时返回非0
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include "../include/common.hpp"
+#include "../include/frame_replay.hpp"
+#include "../include/recorded_backend.hpp"
+#include "../include/stage_executor.hpp"
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <opencv2/opencv.hpp>
+
+using namespace std;
+using namespace cv;
+
+/**
+ * @brief 流水线帧槽位
+ *
+ */
+struct BenchmarkFrame {
+  int index = 0;
+  Mat imageBinary;
+  vector<PredictResult> predicts;
+};
+
+vector<Mat> frames;
+map<int, vector<PredictResult>> predicts;
+
+/**
+ * @brief 流水线初始化：不显示、不存图
+ *
+ */
+void pipelineInit(IcarPipeline &pipeline) {
+  replayInit(pipeline);
+  pipeline.start(0);
+}
+
+vector<PredictResult> framePredicts(int index) {
+  auto it = predicts.find(index);
+  return it == predicts.end() ? vector<PredictResult>() : it->second;
+}
+
+double frameTime(int index) { return index * 1000.0 / 30; }
+
+int main(int argc, char *argv[]) {
+  string pathFrames = "../res/regression/track/";
+  string pathPredicts = "-";
+  int corePreprocess = 2, coreControl = 3;
+  if (argc > 1)
+    pathFrames = argv[1];
+  if (argc > 2)
+    pathPredicts = argv[2];
+  if (argc > 3)
+    corePreprocess = atoi(argv[3]);
+  if (argc > 4)
+    coreControl = atoi(argv[4]);
+
+  FrameSource::load(pathFrames, frames);
+  for (Mat &frame : frames)
+    resize(frame, frame, Size(COLSIMAGE, ROWSIMAGE));
+  if (frames.empty()) {
+    cout << "Error: no frame in " << pathFrames << endl;
+    return -1;
+  }
+  if (pathPredicts != "-")
+    RecordedBackend::load(pathPredicts, predicts);
+
+  // 串行
+  vector<FrameOutput> outputSerial;
+  {
+    IcarPipeline pipeline;
+    pipelineInit(pipeline);
+    double latencyTotal = 0, latencyMax = 0;
+    auto begin = chrono::steady_clock::now();
+    for (int i = 0; i < frames.size(); i++) {
+      vector<PredictResult> input = framePredicts(i);
+      auto t0 = chrono::steady_clock::now();
+      pipeline.process(frames[i], input, frameTime(i));
+      double ms =
+          chrono::duration<double, milli>(chrono::steady_clock::now() - t0)
+              .count();
+      latencyTotal += ms;
+      latencyMax = max(latencyMax, ms);
+      outputSerial.push_back(FrameOutput::from(pipeline));
+      if (pipeline.finish)
+        break;
+    }
+    double seconds =
+        chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+    cout << "frames: " << outputSerial.size() << " [" << pathFrames << "]"
+         << endl;
+    cout << "[serial]   " << outputSerial.size() / seconds
+         << "fps, latency mean: " << latencyTotal / outputSerial.size()
+         << "ms max: " << latencyMax << "ms" << endl;
+  }
+
+  // 流水线：在途帧数1~3
+  int mismatches = 0;
+  for (int depth = 1; depth <= 3; depth++) {
+    IcarPipeline pipeline;
+    pipelineInit(pipeline);
+    vector<FrameOutput> output;
+    int next = 0;
+
+    StagedExecutor<BenchmarkFrame> executor;
+    using Slot = StagedExecutor<BenchmarkFrame>::Slot;
+    executor.addStage(
+        "preprocess",
+        [&](Slot &slot) {
+          if (next >= frames.size())
+            return false;
+          slot.data.index = next++;
+          slot.data.predicts = framePredicts(slot.data.index);
+          pipeline.preprocess(frames[slot.data.index], slot.data.imageBinary);
+          return true;
+        },
+        corePreprocess);
+    executor.addStage(
+        "control",
+        [&](Slot &slot) {
+          pipeline.recognize(slot.data.imageBinary, slot.data.predicts,
+                             frameTime(slot.data.index));
+          output.push_back(FrameOutput::from(pipeline));
+          return !pipeline.finish;
+        },
+        coreControl);
+
+    auto begin = chrono::steady_clock::now();
+    executor.start(depth);
+    executor.wait();
+    double seconds =
+        chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+
+    cout << "[depth " << depth << "]  " << output.size() / seconds
+         << "fps, latency mean: " << executor.latencyMean()
+         << "ms max: " << executor.latencyMax() << "ms" << endl;
+    executor.printStatistics();
+
+    int mismatch = output.size() != outputSerial.size();
+    for (int i = 0; i < min(output.size(), outputSerial.size()); i++) {
+      if (output[i] != outputSerial[i]) {
+        if (mismatch++ == 0)
+          cout << "Error: output mismatch at frame [" << i << "]" << endl;
+      }
+    }
+    mismatches += mismatch;
+  }
+
+  cout << "output mismatches: " << mismatches << endl;
+  return mismatches ? 1 : 0;
+}
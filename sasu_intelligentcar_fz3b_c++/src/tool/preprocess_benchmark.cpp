@@ -0,0 +1,161 @@
+/**
+ * @file preprocess_benchmark.cpp
+ * @author lse
+ * @brief AI预处理：逐帧分配（旧）、复用上下文/暂存内存（新）与融合内核的耗时、结果及堆内存分配对比
+ * @version 0.1
+ * @date 2023-07-20
+ * @note 在build目录下运行：./preprocess_benchmark [视频路径|图像文件夹|运行日志] [模型路径] [循环次数]
+ *       默认使用../res/regression/track/、../res/model/mobilenet-ssd（需Paddle Lite）
+ *       旧/新对比与整帧推理均使用Paddle图像预处理库（fused_preprocess = false），融合内核单独计时
+ *       稳态预处理/整帧推理存在堆内存分配，或非连续图像与连续图像的预处理结果不一致时返回非0
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include "../include/alloc_counter.hpp"
+#include "../include/common.hpp"
+#include "../include/frame_source.hpp"
+#include "../include/paddle_backend.hpp"
+#include <chrono>
+#include <iostream>
+#include <opencv2/opencv.hpp>
+
+using namespace std;
+using namespace cv;
+
+/**
+ * @brief 旧预处理：每帧申请暂存内存、拷贝图像、创建预处理上下文
+ *
+ */
+void preprocessLegacy(Mat &img, shared_ptr<ModelConfig> &config,
+                      Tensor *tensor) {
+  uint8_t *src = (uint8_t *)malloc(3 * img.cols * img.rows);
+  for (int i = 0; i < img.rows; ++i)
+    memcpy(src + i * img.cols * 3, img.ptr<uint8_t>(i), img.cols * 3);
+  TransParam tparam;
+  tparam.ih = img.rows;
+  tparam.iw = img.cols;
+  tparam.oh = config->input_height;
+  tparam.ow = config->input_width;
+  Preprocess preprocess(
+      ImageFormat::BGR,
+      config->format == "RGB" ? ImageFormat::RGB : ImageFormat::BGR, tparam);
+  preprocess.image_to_tensor(src, tensor, LayoutType::kNHWC, config->means,
+                             config->scales);
+  free(src);
+}
+
+int main(int argc, char *argv[]) {
+  string pathFrames = "../res/regression/track/";
+  string pathModel = "../res/model/mobilenet-ssd";
+  int loops = 10;
+  if (argc > 1)
+    pathFrames = argv[1];
+  if (argc > 2)
+    pathModel = argv[2];
+  if (argc > 3)
+    loops = atoi(argv[3]);
+
+  vector<Mat> frames;
+  FrameSource::load(pathFrames, frames);
+  for (Mat &frame : frames)
+    resize(frame, frame, Size(COLSIMAGE, ROWSIMAGE));
+  if (frames.empty()) {
+    cout << "Error: no frame in " << pathFrames << endl;
+    return -1;
+  }
+  cout << "frames: " << frames.size() << " [" << pathFrames << "]" << endl;
+
+  shared_ptr<ModelConfig> config = make_shared<ModelConfig>(pathModel, "paddle");
+  config->fused_preprocess = false; // Paddle图像预处理库：复用上下文路径
+  PaddleBackend backend;
+  if (backend.init(config) != 0)
+    return -1;
+  Tensor *input = backend.input();
+  size_t tensorSize = 3 * config->input_width * config->input_height;
+  int errors = 0;
+
+  shared_ptr<ModelConfig> fusedConfig = make_shared<ModelConfig>(*config);
+  fusedConfig->fused_preprocess = true;
+  FpgaPreprocess fused; // 融合内核：单独计时与检查
+  fused.init(fusedConfig);
+
+  //[1] 结果校验：非连续图像（ROI）与连续图像的预处理结果一致
+  Mat padded;
+  copyMakeBorder(frames[0], padded, 0, 0, 0, 16, BORDER_CONSTANT);
+  Mat roi = padded(Rect(0, 0, frames[0].cols, frames[0].rows)); // 非连续
+  for (FpgaPreprocess *preprocess : {&backend.preprocess(), &fused}) {
+    preprocess->run(frames[0], input);
+    vector<float> expected(input->data<float>(),
+                           input->data<float>() + tensorSize);
+    preprocess->run(roi, input);
+    if (memcmp(expected.data(), input->data<float>(),
+               tensorSize * sizeof(float)) != 0) {
+      cout << "Error: non-continuous image preprocess mismatch ("
+           << (preprocess == &fused ? "fused" : "persistent") << ")!" << endl;
+      errors++;
+    }
+  }
+
+  //[2] 耗时对比
+  double timeLegacy = 0, timePersistent = 0, timeFused = 0;
+  for (int n = 0; n < loops; n++) {
+    for (int i = 0; i < frames.size(); i++) {
+      auto t0 = chrono::steady_clock::now();
+      preprocessLegacy(frames[i], config, input);
+      auto t1 = chrono::steady_clock::now();
+      backend.preprocess().run(frames[i], input);
+      auto t2 = chrono::steady_clock::now();
+      fused.run(frames[i], input);
+      auto t3 = chrono::steady_clock::now();
+      timeLegacy += chrono::duration<double, milli>(t1 - t0).count();
+      timePersistent += chrono::duration<double, milli>(t2 - t1).count();
+      timeFused += chrono::duration<double, milli>(t3 - t2).count();
+    }
+  }
+  int counter = loops * frames.size();
+  cout << "[legacy]     malloc/copy/context: " << timeLegacy / counter
+       << "ms/frame" << endl;
+  cout << "[persistent] reused buffers     : " << timePersistent / counter
+       << "ms/frame" << endl;
+  cout << "[fused]      fused kernel       : " << timeFused / counter
+       << "ms/frame" << endl;
+  cout << "speedup: " << timeLegacy / timePersistent << "x (persistent), "
+       << timeLegacy / timeFused << "x (fused)" << endl;
+
+  //[3] 稳态堆内存分配：预处理（两种实现）、结果解析与整帧推理均为0
+  vector<PredictResult> results;
+  for (int i = 0; i < 3; i++) // 预热：结果容器扩容
+    backend.run(frames[i % frames.size()], results, i + 1);
+  results.reserve(64);
+  uint64_t reallocs = backend.preprocess().reallocs();
+
+  uint64_t allocs = allocCount();
+  for (int i = 0; i < frames.size(); i++) {
+    backend.preprocess().run(frames[i], input);
+    backend.preprocess().run(roi, input);
+    fused.run(frames[i], input);
+    fused.run(roi, input);
+  }
+  uint64_t allocsPreprocess = allocCount() - allocs;
+
+  allocs = allocCount();
+  for (int i = 0; i < frames.size(); i++)
+    backend.run(frames[i], results, i + 1);
+  uint64_t allocsInference = allocCount() - allocs;
+
+  cout << "steady-state allocations: preprocess = " << allocsPreprocess
+       << ", inference = " << allocsInference << " ("
+       << (double)allocsInference / frames.size() << "/frame)"
+       << ", context rebuilds = " << backend.preprocess().reallocs() - reallocs
+       << endl;
+  if (allocsPreprocess || backend.preprocess().reallocs() != reallocs) {
+    cout << "Error: preprocess allocates in steady state!" << endl;
+    errors++;
+  }
+  if (allocsInference) {
+    cout << "Error: inference allocates in steady state!" << endl;
+    errors++;
+  }
+
+  return errors ? 1 : 0;
+}
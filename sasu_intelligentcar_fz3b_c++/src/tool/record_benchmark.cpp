@@ -0,0 +1,87 @@
+/**
+ * @file record_benchmark.cpp
+ * @author lse
+ * @brief 存图：同步imwrite与异步存图（后台编码写入）对调用线程的耗时对比
+ * @version 0.1
+ * @date 2023-07-25
+ * @note 在build目录下运行：./record_benchmark [视频路径|图像文件夹|运行日志] [每帧存图数] [槽位数] [队满等待]
+ *       默认使用../res/regression/track/，每帧4张（调试模式下的存图次数），8槽位，队满丢弃
+ *       图像写入../res/samples/train/，运行前可清空该目录
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include "../include/common.hpp"
+#include "../include/frame_source.hpp"
+#include <chrono>
+#include <iostream>
+#include <opencv2/opencv.hpp>
+
+using namespace std;
+using namespace cv;
+
+int main(int argc, char *argv[]) {
+  string pathFrames = "../res/regression/track/";
+  int perFrame = 4;
+  int slots = 8;
+  bool block = false;
+  if (argc > 1)
+    pathFrames = argv[1];
+  if (argc > 2)
+    perFrame = atoi(argv[2]);
+  if (argc > 3)
+    slots = atoi(argv[3]);
+  if (argc > 4)
+    block = atoi(argv[4]);
+
+  vector<Mat> frames;
+  FrameSource::load(pathFrames, frames);
+  for (Mat &frame : frames)
+    resize(frame, frame, Size(COLSIMAGE, ROWSIMAGE));
+  if (frames.empty()) {
+    cout << "Error: no frame in " << pathFrames << endl;
+    return -1;
+  }
+
+  // 同步：调用线程编码写文件
+  double timeSync = 0, maxSync = 0;
+  for (int i = 0; i < frames.size(); i++) {
+    auto start = chrono::steady_clock::now();
+    for (int k = 0; k < perFrame; k++)
+      imwrite("../res/samples/train/sync" + to_string(k) + ".jpg", frames[i]);
+    double ms =
+        chrono::duration<double, milli>(chrono::steady_clock::now() - start)
+            .count();
+    timeSync += ms;
+    maxSync = max(maxSync, ms);
+  }
+
+  // 异步：按30fps节拍提交，模拟控制周期
+  Recorder &recorder = Recorder::instance();
+  recorder.init(slots, block);
+  double timeAsync = 0, maxAsync = 0;
+  auto period = chrono::microseconds(33333);
+  auto next = chrono::steady_clock::now();
+  for (int i = 0; i < frames.size(); i++) {
+    auto start = chrono::steady_clock::now();
+    for (int k = 0; k < perFrame; k++)
+      savePicture(frames[i]);
+    double ms =
+        chrono::duration<double, milli>(chrono::steady_clock::now() - start)
+            .count();
+    timeAsync += ms;
+    maxAsync = max(maxAsync, ms);
+    next += period;
+    this_thread::sleep_until(next);
+  }
+  recorder.stop();
+
+  cout << "frames: " << frames.size() << " [" << pathFrames
+       << "], pictures/frame: " << perFrame << ", slots: " << slots
+       << (block ? " (block)" : " (drop)") << endl;
+  cout << "[sync]  " << timeSync / frames.size() << "ms/frame, max " << maxSync
+       << "ms" << endl;
+  cout << "[async] " << timeAsync / frames.size() << "ms/frame, max "
+       << maxAsync << "ms" << endl;
+  recorder.printStatistics();
+  return 0;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file runlog_benchmark.cpp
+ * @author lse
+ * @brief 运行日志：逐帧编号图片与单文件运行日志的写入/读取耗时对比，并校验读回数据
+ * @version 0.1
+ * @date 2023-07-26
+ * @note 在build目录下运行：./runlog_benchmark [视频路径|图像文件夹|运行日志] [重复次数] [输出目录]
+ *       默认使用../res/regression/track/，重复3次（模拟长时间运行），输出到/tmp/
+ *       依次测试：编号JPG图片、运行日志（原始数据）、运行日志（JPEG）、后台写入（原始数据，
+ *       write为控制线程拷入槽位的耗时，队满丢弃的帧不计入校验），读回数据与输入不一致时返回非0
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include "../include/common.hpp"
+#include "../include/frame_source.hpp"
+#include "../include/run_log.hpp"
+#include <chrono>
+#include <iostream>
+#include <opencv2/opencv.hpp>
+
+using namespace std;
+using namespace cv;
+
+double elapsedMs(chrono::steady_clock::time_point start) {
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - start)
+      .count();
+}
+
+/**
+ * @brief 单帧记录：附加固定的检测结果与赛道边缘
+ *
+ * @param copy 图像拷入记录（后台写入的槽位）
+ */
+void frameRecord(RunLogFrame &record, Mat &frame, int index, bool copy = false) {
+  record.frameId = index + 1;
+  record.time = index * 1000.0 / 30;
+  if (copy)
+    frame.copyTo(record.image);
+  else
+    record.image = frame;
+  record.predicts.assign(3, PredictResult{LABEL_CONE, "", 0.8f, index % 300, 100, 12, 16});
+  record.edgeLeft.resize(ROWSIMAGE / 2);
+  record.edgeRight.resize(ROWSIMAGE / 2);
+  for (int i = 0; i < ROWSIMAGE / 2; i++) {
+    record.edgeLeft[i] = POINT(ROWSIMAGE - 1 - i, 40 + i / 4);
+    record.edgeRight[i] = POINT(ROWSIMAGE - 1 - i, 280 - i / 4);
+  }
+  record.roadType = index % 10;
+  record.servoPwm = PWMSERVOMID + index % 100;
+}
+
+int main(int argc, char *argv[]) {
+  string pathFrames = "../res/regression/track/";
+  int repeat = 3;
+  string pathOutput = "/tmp/";
+  if (argc > 1)
+    pathFrames = argv[1];
+  if (argc > 2)
+    repeat = atoi(argv[2]);
+  if (argc > 3)
+    pathOutput = argv[3];
+
+  vector<Mat> frames;
+  FrameSource::load(pathFrames, frames);
+  for (Mat &frame : frames)
+    resize(frame, frame, Size(COLSIMAGE, ROWSIMAGE));
+  if (frames.empty()) {
+    cout << "Error: no frame in " << pathFrames << endl;
+    return -1;
+  }
+  int count = frames.size() * repeat;
+  cout << "frames: " << count << " [" << pathFrames << "] x" << repeat << endl;
+
+  // 编号JPG图片
+  auto start = chrono::steady_clock::now();
+  for (int i = 0; i < count; i++)
+    imwrite(pathOutput + to_string(i + 1) + ".jpg", frames[i % frames.size()]);
+  double timeWrite = elapsedMs(start);
+  start = chrono::steady_clock::now();
+  Mat frame;
+  for (int i = 0; i < count; i++)
+    frame = imread(pathOutput + to_string(i + 1) + ".jpg");
+  double timeRead = elapsedMs(start);
+  cout << "[jpg files]     write " << timeWrite / count << "ms/frame, read "
+       << timeRead / count << "ms/frame" << endl;
+  for (int i = 0; i < count; i++)
+    remove((pathOutput + to_string(i + 1) + ".jpg").c_str());
+
+  int errors = 0;
+  RunLogFrame record, loaded;
+  for (int mode = 0; mode < 3; mode++) {
+    bool jpeg = mode == 1;
+    bool async = mode == 2;
+    string path = pathOutput + "benchmark.runlog";
+    uint64_t bytes = 0, dropped = 0;
+    double timeClose = 0;
+    if (async) {
+      RunLogQueue queue;
+      queue.open(path, 0, jpeg);
+      start = chrono::steady_clock::now();
+      for (int i = 0; i < count; i++) {
+        RunLogFrame *slot = queue.acquire();
+        if (slot == nullptr)
+          continue;
+        frameRecord(*slot, frames[i % frames.size()], i, true);
+        queue.commit();
+      }
+      timeWrite = elapsedMs(start);
+      queue.close();
+      timeClose = elapsedMs(start);
+      bytes = queue.bytes();
+      dropped = queue.dropped();
+    } else {
+      RunLogWriter writer;
+      writer.open(path, 0, jpeg);
+      start = chrono::steady_clock::now();
+      for (int i = 0; i < count; i++) {
+        frameRecord(record, frames[i % frames.size()], i);
+        writer.write(record);
+      }
+      writer.close();
+      timeWrite = elapsedMs(start);
+      bytes = writer.bytes();
+    }
+
+    RunLogReader reader;
+    start = chrono::steady_clock::now();
+    reader.open(path);
+    for (int i = 0; i < reader.size(); i++) {
+      reader.read(i, loaded);
+      int index = loaded.frameId - 1; // 后台写入：丢弃的帧不在日志中
+      frameRecord(record, frames[index % frames.size()], index);
+      bool same = loaded.frameId == record.frameId &&
+                  loaded.servoPwm == record.servoPwm &&
+                  loaded.predicts.size() == record.predicts.size() &&
+                  loaded.edgeLeft.size() == record.edgeLeft.size() &&
+                  loaded.edgeRight.back().y == record.edgeRight.back().y &&
+                  loaded.image.size() == record.image.size();
+      if (same && !jpeg) // 原始存储：逐像素一致
+        same = norm(loaded.image, record.image, NORM_INF) == 0;
+      if (!same && errors++ == 0)
+        cout << "Error: run log record [" << i << "] mismatch" << endl;
+    }
+    timeRead = elapsedMs(start);
+    if (reader.size() + dropped != count && errors++ == 0)
+      cout << "Error: run log records " << reader.size() << " + dropped "
+           << dropped << " != " << count << endl;
+    reader.close();
+    remove(path.c_str());
+
+    cout << (async ? "[runlog queue]  " : jpeg ? "[runlog jpeg]   " : "[runlog raw]    ")
+         << "write " << timeWrite / count << "ms/frame, read "
+         << timeRead / count << "ms/frame, " << bytes / 1048576.0 << "MB";
+    if (async)
+      cout << ", drained " << timeClose / count << "ms/frame, dropped "
+           << dropped;
+    cout << endl;
+  }
+
+  cout << "errors: " << errors << endl;
+  return errors ? 1 : 0;
+}
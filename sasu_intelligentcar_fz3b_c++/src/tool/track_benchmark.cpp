@@ -0,0 +1,197 @@
+/**
+ * @file track_benchmark.cpp
+ * @author lse
+ * @brief 赛道识别：逐像素色块搜索（旧）、位掩码游程提取（新）与帧间跟踪的结果校验及耗时对比
+ * @version 0.1
+ * @date 2023-07-20
+ * @note 在build目录下运行：./track_benchmark [视频路径|图像文件夹|运行日志] [循环次数]
+ *       默认使用../res/regression/track/，不存在时使用标定图像
+ *       各搜索方式的边缘结果与逐像素搜索不一致时返回非0
+ *       帧间跟踪需按录制顺序输入连续帧，同时输出跟踪命中率
+ *       另在赛道外侧叠加斑马线色块，校验帧间跟踪与整行搜索的车库识别结果（garageEnable）一致
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include "../include/common.hpp"
+#include "../include/frame_source.hpp"
+#include "../src/image_preprocess.cpp"
+#include "../src/recognition/track_recognition.cpp"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <opencv2/highgui.hpp>
+#include <opencv2/opencv.hpp>
+
+using namespace std;
+using namespace cv;
+
+/**
+ * @brief 点集比较
+ *
+ */
+bool samePoints(vector<POINT> &a, vector<POINT> &b) {
+  if (a.size() != b.size())
+    return false;
+  for (int i = 0; i < a.size(); i++) {
+    if (a[i].x != b[i].x || a[i].y != b[i].y || a[i].slope != b[i].slope)
+      return false;
+  }
+  return true;
+}
+
+/**
+ * @brief 赛道识别结果比较：边缘/色块宽度/岔路/车库
+ *
+ */
+bool sameTrack(TrackRecognition &a, TrackRecognition &b) {
+  return samePoints(a.pointsEdgeLeft, b.pointsEdgeLeft) &&
+         samePoints(a.pointsEdgeRight, b.pointsEdgeRight) &&
+         samePoints(a.widthBlock, b.widthBlock) &&
+         samePoints(a.spurroad, b.spurroad) &&
+         a.garageEnable.x == b.garageEnable.x &&
+         a.garageEnable.y == b.garageEnable.y;
+}
+
+/**
+ * @brief 在赛道外侧（较宽一侧）叠加斑马线色块：跟踪窗口之外，只有整行搜索能看到
+ *
+ * @param track 原图的整行搜索结果
+ * @param binary 二值化图像（原地修改）
+ * @return true 已叠加（各行外侧宽度均不足时不叠加）
+ */
+bool drawZebra(TrackRecognition &track, Mat &binary) {
+  for (int i = 0; i < track.pointsEdgeLeft.size(); i++) { // 由近及远取外侧足够宽的行
+    int row = track.pointsEdgeLeft[i].x;
+    int left = track.pointsEdgeLeft[i].y - 20; // 留出跟踪窗口
+    int right = track.pointsEdgeRight[i].y + 20;
+    int start = 2, end = left; // 斑马线列范围
+    if (COLSIMAGE - right > left) {
+      start = right;
+      end = COLSIMAGE - 2;
+    }
+    if (end - start < 110 || row < 4) // 至少5个斑马线色块：加上赛道共6个以上
+      continue;
+    for (int col = start; col + 10 <= end; col += 20)
+      rectangle(binary, Point(col, row - 3), Point(col + 9, row + 3),
+                Scalar(255), -1);
+    return true;
+  }
+  return false;
+}
+
+int main(int argc, char *argv[]) {
+  string path = "../res/regression/track/";
+  int loops = 10;
+  if (argc > 1)
+    path = argv[1];
+  if (argc > 2)
+    loops = atoi(argv[2]);
+
+  vector<Mat> frames;
+  FrameSource::load(path, frames);
+  if (frames.empty()) {
+    path = "../res/calibration/corners/";
+    FrameSource::load(path, frames);
+  }
+  if (frames.empty()) {
+    cout << "Error: no frame in " << path << endl;
+    return -1;
+  }
+  cout << "frames: " << frames.size() << " [" << path << "]" << endl;
+
+  // 预处理：与icar一致，只执行一次
+  ImagePreprocess imagePreprocess;
+  imagePreprocess.imageCorrecteInit();
+  vector<Mat> binarys;
+  for (int i = 0; i < frames.size(); i++) {
+    resize(frames[i], frames[i], Size(COLSIMAGE, ROWSIMAGE));
+    Mat imageCorrect = imagePreprocess.imageCorrection(frames[i]);
+    Mat imageLight = imagePreprocess.imageHighLight(imageCorrect, -50);
+    binarys.push_back(imagePreprocess.imageBinaryzation(imageLight));
+  }
+
+  TrackRecognition trackScalar, trackRunLength, trackTracking;
+  trackScalar.runLengthEnable = false;
+  trackRunLength.runLengthEnable = true;
+  trackTracking.runLengthEnable = true;
+  trackTracking.trackingEnable = true;
+
+  //[1] 结果校验
+  int mismatch = 0, mismatchTracking = 0;
+  for (int i = 0; i < binarys.size(); i++) {
+    trackScalar.trackRecognition(binarys[i]);
+    trackRunLength.trackRecognition(binarys[i]);
+    trackTracking.trackRecognition(binarys[i]);
+    if (!sameTrack(trackScalar, trackRunLength)) {
+      cout << "Error: frame [" << i << "] edge mismatch!" << endl;
+      mismatch++;
+    }
+    if (!sameTrack(trackScalar, trackTracking)) {
+      cout << "Error: frame [" << i << "] tracking edge mismatch!" << endl;
+      mismatchTracking++;
+    }
+  }
+  cout << "mismatch frames: " << mismatch << "/" << binarys.size() << endl;
+  cout << "tracking mismatch frames: " << mismatchTracking << "/"
+       << binarys.size() << endl;
+  cout << "tracking hit rows: " << trackTracking.trackingHits << "/"
+       << trackTracking.trackingHits + trackTracking.trackingMisses << " ("
+       << trackTracking.trackingRatio() * 100 << "%), tracking frames: "
+       << trackTracking.trackingFrames << "/"
+       << trackTracking.trackingFrames + trackTracking.trackingFullFrames
+       << endl;
+
+  //[1b] 赛道外侧的斑马线（每3帧1帧，其余帧恢复跟踪）：跟踪与整行搜索的车库识别结果一致
+  int zebraFrames = 0, garageFrames = 0, mismatchGarage = 0;
+  TrackRecognition trackZebra = trackTracking;
+  trackZebra.trackingReset();
+  for (int i = 0; i < binarys.size(); i++) {
+    Mat binaryZebra = binarys[i].clone();
+    if (i % 3 == 2) {
+      trackScalar.trackRecognition(binarys[i]);
+      if (drawZebra(trackScalar, binaryZebra))
+        zebraFrames++;
+    }
+    trackScalar.trackRecognition(binaryZebra);
+    trackZebra.trackRecognition(binaryZebra);
+    if (trackScalar.garageEnable.x)
+      garageFrames++;
+    if (!sameTrack(trackScalar, trackZebra)) {
+      cout << "Error: frame [" << i << "] tracking garage mismatch!" << endl;
+      mismatchGarage++;
+    }
+  }
+  cout << "zebra frames: " << zebraFrames << ", garage frames: " << garageFrames
+       << ", tracking mismatch frames: " << mismatchGarage << "/"
+       << binarys.size() << endl;
+
+  //[2] 耗时对比
+  double timeScalar = 0, timeRunLength = 0, timeTracking = 0;
+  trackTracking.trackingReset();
+  for (int n = 0; n < loops; n++) {
+    for (int i = 0; i < binarys.size(); i++) {
+      auto start = chrono::steady_clock::now();
+      trackScalar.trackRecognition(binarys[i]);
+      auto mid = chrono::steady_clock::now();
+      trackRunLength.trackRecognition(binarys[i]);
+      auto end = chrono::steady_clock::now();
+      trackTracking.trackRecognition(binarys[i]);
+      auto endTracking = chrono::steady_clock::now();
+      timeScalar += chrono::duration<double, milli>(mid - start).count();
+      timeRunLength += chrono::duration<double, milli>(end - mid).count();
+      timeTracking +=
+          chrono::duration<double, milli>(endTracking - end).count();
+    }
+  }
+  int counter = loops * binarys.size();
+  cout << "[scalar]     pixel compare: " << timeScalar / counter << "ms/frame"
+       << endl;
+  cout << "[run-length] bitmask ctz  : " << timeRunLength / counter
+       << "ms/frame" << endl;
+  cout << "[tracking]   edge window  : " << timeTracking / counter
+       << "ms/frame" << endl;
+  cout << "speedup: " << timeScalar / timeRunLength << "x (run-length), "
+       << timeScalar / timeTracking << "x (tracking)" << endl;
+
+  return (mismatch || mismatchTracking || mismatchGarage) ? 1 : 0;
+}